@@ -9,31 +9,57 @@
 
 #include "MiniStack.hpp"
 #include "MiniQueue.hpp"
+#include "MiniSpscQueue.hpp"
+#include "MiniMpmcQueue.hpp"
 #include <iostream>
 #include <string>
 #include <sstream>
-#include <chrono> // high_resolution_clock
+#include <chrono> // steady_clock
 #include <stack>
 #include <queue>
 #include <cstdint>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <atomic>
+#include <array>
+#include <span>
 
 std::chrono::steady_clock::time_point startTimer();
 std::chrono::milliseconds endTimer(const std::chrono::steady_clock::time_point& time);
 
 void queueTest();
 void stackTest();
+void spscQueueTest();
+void mpmcQueueTest();
 
 void miniStackPushPops(const std::size_t iterations);
+void miniStackGrowPushPops(const std::size_t iterations);
+std::uint64_t miniStackBatchPushPops(const std::size_t iterations, const bool bulk);
 void stackPushPops(const std::size_t iterations);
 
-void miniQueuePushPops(const std::size_t iterations);
-void queuePushPops(const std::size_t iterations);
+template <typename Queue>
+std::uint64_t fillAndDrain(Queue& queue, const std::size_t iterations);
+std::uint64_t miniQueueGrowPushPops(const std::size_t iterations);
+std::uint64_t miniQueueBatchPushPops(const std::size_t iterations, const bool bulk);
+template <typename Queue>
+std::uint64_t windowPushPops(Queue& queue, const std::size_t iterations);
+std::uint64_t miniQueueWindowPushPops(const std::size_t iterations);
+std::uint64_t miniQueuePow2WindowPushPops(const std::size_t iterations);
+std::uint64_t queueWindowPushPops(const std::size_t iterations);
+
+void miniSpscQueueHandOff(const std::size_t iterations);
+void lockedMiniQueueHandOff(const std::size_t iterations);
+std::chrono::nanoseconds miniSpscQueueRoundTrip(const std::size_t iterations);
+void miniMpmcQueueHandOff(const std::size_t iterations, const std::size_t producers, const std::size_t consumers);
 
 int main()
 {
   {
     // stackTest();
     // queueTest();
+    // spscQueueTest();
+    // mpmcQueueTest();
   }
 
   {
@@ -45,9 +71,18 @@ int main()
     std::size_t i = 0;
 
     std::chrono::milliseconds totalMiniStack{};
+    std::chrono::milliseconds totalMiniStackGrow{};
+    std::chrono::milliseconds totalMiniStackStaged{};
+    std::chrono::milliseconds totalMiniStackBatch{};
     std::chrono::milliseconds totalStack{};
     std::chrono::milliseconds totalMiniQueue{};
+    std::chrono::milliseconds totalMiniQueuePow2{};
+    std::chrono::milliseconds totalMiniQueueGrow{};
+    std::chrono::milliseconds totalMiniQueueStaged{};
+    std::chrono::milliseconds totalMiniQueueBatch{};
     std::chrono::milliseconds totalQueue{};
+    std::uint64_t queueSums[6]{};
+    std::uint64_t stackBatchSums[2]{};
 
     std::cout << "Running comparisons for " << kIter 
               << " elements\nAveraged over " << kAvgIter << " iterations\n\n";
@@ -61,6 +96,27 @@ int main()
         //std::cout << "MiniStack: " << elapsed << '\n';
       }
 
+      {
+        const auto startTime = startTimer();
+        miniStackGrowPushPops(kIter);
+        std::chrono::milliseconds elapsed = endTimer(startTime);
+        totalMiniStackGrow += elapsed;
+      }
+
+      {
+        const auto startTime = startTimer();
+        stackBatchSums[0] += miniStackBatchPushPops(kIter, false);
+        std::chrono::milliseconds elapsed = endTimer(startTime);
+        totalMiniStackStaged += elapsed;
+      }
+
+      {
+        const auto startTime = startTimer();
+        stackBatchSums[1] += miniStackBatchPushPops(kIter, true);
+        std::chrono::milliseconds elapsed = endTimer(startTime);
+        totalMiniStackBatch += elapsed;
+      }
+
       {
         const auto startTime = startTimer();
         stackPushPops(kIter);
@@ -69,17 +125,55 @@ int main()
         //std::cout << "Stack: " << elapsed << '\n';
       }
 
+      /* The exact and power-of-two queues (and std::queue below) are
+         filled and drained once untimed, to their whole capacity, so the
+         timed pass runs on memory that is already faulted in instead of
+         on however warm the allocator left a fresh 40-64 MB buffer */
       {
+        MiniQueue<int> miniQueue(kIter);
+        fillAndDrain(miniQueue, miniQueue.capacity());
         const auto startTime = startTimer();
-        miniQueuePushPops(kIter);
+        queueSums[0] += fillAndDrain(miniQueue, kIter);
         std::chrono::milliseconds elapsed = endTimer(startTime);
         totalMiniQueue += elapsed;
         //std::cout << "MiniQueue: " << elapsed << '\n';
       }
 
       {
+        MiniQueue<int, PowerOfTwoCapacity> miniQueue(kIter);
+        fillAndDrain(miniQueue, miniQueue.capacity());
+        const auto startTime = startTimer();
+        queueSums[1] += fillAndDrain(miniQueue, kIter);
+        std::chrono::milliseconds elapsed = endTimer(startTime);
+        totalMiniQueuePow2 += elapsed;
+      }
+
+      {
+        const auto startTime = startTimer();
+        queueSums[3] += miniQueueGrowPushPops(kIter);
+        std::chrono::milliseconds elapsed = endTimer(startTime);
+        totalMiniQueueGrow += elapsed;
+      }
+
+      {
+        const auto startTime = startTimer();
+        queueSums[4] += miniQueueBatchPushPops(kIter, false);
+        std::chrono::milliseconds elapsed = endTimer(startTime);
+        totalMiniQueueStaged += elapsed;
+      }
+
+      {
+        const auto startTime = startTimer();
+        queueSums[5] += miniQueueBatchPushPops(kIter, true);
+        std::chrono::milliseconds elapsed = endTimer(startTime);
+        totalMiniQueueBatch += elapsed;
+      }
+
+      {
+        std::queue<int> queue;
+        fillAndDrain(queue, kIter);
         const auto startTime = startTimer();
-        queuePushPops(kIter);
+        queueSums[2] += fillAndDrain(queue, kIter);
         std::chrono::milliseconds elapsed = endTimer(startTime);
         totalQueue += elapsed;
         //std::cout << "Queue: " << elapsed << '\n';
@@ -96,13 +190,27 @@ int main()
       << std::chrono::duration_cast<std::chrono::milliseconds>(totalQueue).count() / static_cast<double>(kAvgIter) << " milliseconds\n";
     */
     double avgMiniStackTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniStack).count() / static_cast<double>(kAvgIter);
+    double avgMiniStackGrowTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniStackGrow).count() / static_cast<double>(kAvgIter);
+    double avgMiniStackStagedTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniStackStaged).count() / static_cast<double>(kAvgIter);
+    double avgMiniStackBatchTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniStackBatch).count() / static_cast<double>(kAvgIter);
     double avgStackTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalStack).count() / static_cast<double>(kAvgIter);
     double avgMiniQueueTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniQueue).count() / static_cast<double>(kAvgIter);
+    double avgMiniQueuePow2Time = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniQueuePow2).count() / static_cast<double>(kAvgIter);
+    double avgMiniQueueGrowTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniQueueGrow).count() / static_cast<double>(kAvgIter);
+    double avgMiniQueueStagedTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniQueueStaged).count() / static_cast<double>(kAvgIter);
+    double avgMiniQueueBatchTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalMiniQueueBatch).count() / static_cast<double>(kAvgIter);
     double avgQueueTime = std::chrono::duration_cast<std::chrono::milliseconds>(totalQueue).count() / static_cast<double>(kAvgIter);
 
     std::cout << "Average MiniStack Time: " << avgMiniStackTime << " milliseconds\n";
+    std::cout << "Average MiniStack (growable) Time: " << avgMiniStackGrowTime << " milliseconds\n";
+    std::cout << "Average MiniStack (batches of 64, push/pop) Time: " << avgMiniStackStagedTime << " milliseconds\n";
+    std::cout << "Average MiniStack (batches of 64, push_bulk/pop_bulk) Time: " << avgMiniStackBatchTime << " milliseconds\n";
     std::cout << "Average Stack Time: " << avgStackTime << " milliseconds\n";
     std::cout << "Average MiniQueue Time: " << avgMiniQueueTime << " milliseconds\n";
+    std::cout << "Average MiniQueue (power of two) Time: " << avgMiniQueuePow2Time << " milliseconds\n";
+    std::cout << "Average MiniQueue (growable) Time: " << avgMiniQueueGrowTime << " milliseconds\n";
+    std::cout << "Average MiniQueue (batches of 64, push/pop) Time: " << avgMiniQueueStagedTime << " milliseconds\n";
+    std::cout << "Average MiniQueue (batches of 64, push_bulk/pop_bulk) Time: " << avgMiniQueueBatchTime << " milliseconds\n";
     std::cout << "Average Queue Time: " << avgQueueTime << " milliseconds\n";
 
 
@@ -111,21 +219,114 @@ int main()
     double stackTimeRatio = avgStackTime / avgMiniStackTime;
     std::cout << "Stack Time Difference (Standard - Custom): " << stackTimeDifference << " milliseconds\n";
     std::cout << "Stack Time Ratio (Standard / Custom): " << stackTimeRatio << "\n";
+    std::cout << "Stack Time Ratio (Standard / Custom growable): " << avgStackTime / avgMiniStackGrowTime << "\n";
+    std::cout << "Stack Time Ratio (push/pop / push_bulk/pop_bulk): " << avgMiniStackStagedTime / avgMiniStackBatchTime << "\n";
 
     double queueTimeDifference = avgQueueTime - avgMiniQueueTime;
     double queueTimeRatio = avgQueueTime / avgMiniQueueTime;
     std::cout << "Queue Time Difference (Standard - Custom): " << queueTimeDifference << " milliseconds\n";
     std::cout << "Queue Time Ratio (Standard / Custom): " << queueTimeRatio << "\n";
+
+    // Before (ExactCapacity) and after (PowerOfTwoCapacity)
+    std::cout << "Queue Time Ratio (Standard / Custom power of two): " << avgQueueTime / avgMiniQueuePow2Time << "\n";
+    std::cout << "Queue Time Ratio (Custom / Custom power of two): " << avgMiniQueueTime / avgMiniQueuePow2Time << "\n";
+    std::cout << "Queue Time Ratio (Standard / Custom growable): " << avgQueueTime / avgMiniQueueGrowTime << "\n";
+    std::cout << "Queue Time Ratio (push/pop / push_bulk/pop_bulk): " << avgMiniQueueStagedTime / avgMiniQueueBatchTime << "\n";
+    if (queueSums[0] != queueSums[2] || queueSums[1] != queueSums[2] || queueSums[3] != queueSums[2] ||
+        queueSums[4] != queueSums[2] || queueSums[5] != queueSums[2]) {
+      std::cout << "Queues disagree on the elements popped\n";
+    }
+    if (stackBatchSums[0] != queueSums[2] || stackBatchSums[1] != queueSums[2]) {
+      std::cout << "Batched stacks popped different elements\n";
+    }
+
+    /* Filling and draining kIter elements runs once straight through the
+       buffer; a queue that stays a few hundred deep and keeps wrapping
+       shows the cost of the index arithmetic itself */
+    std::chrono::milliseconds totalWindowMiniQueue{};
+    std::chrono::milliseconds totalWindowMiniQueuePow2{};
+    std::chrono::milliseconds totalWindowQueue{};
+    std::uint64_t windowSums[3]{};
+    for (i = 0; i < kAvgIter; ++i) {
+      {
+        const auto startTime = startTimer();
+        windowSums[0] += miniQueueWindowPushPops(kIter);
+        totalWindowMiniQueue += endTimer(startTime);
+      }
+      {
+        const auto startTime = startTimer();
+        windowSums[1] += miniQueuePow2WindowPushPops(kIter);
+        totalWindowMiniQueuePow2 += endTimer(startTime);
+      }
+      {
+        const auto startTime = startTimer();
+        windowSums[2] += queueWindowPushPops(kIter);
+        totalWindowQueue += endTimer(startTime);
+      }
+    }
+    double avgWindowMiniQueueTime = totalWindowMiniQueue.count() / static_cast<double>(kAvgIter);
+    double avgWindowMiniQueuePow2Time = totalWindowMiniQueuePow2.count() / static_cast<double>(kAvgIter);
+    double avgWindowQueueTime = totalWindowQueue.count() / static_cast<double>(kAvgIter);
+
+    std::cout << "\nWindowed queue, 500 deep, " << kIter << " push/front/pop\n";
+    std::cout << "Average MiniQueue Time: " << avgWindowMiniQueueTime << " milliseconds\n";
+    std::cout << "Average MiniQueue (power of two) Time: " << avgWindowMiniQueuePow2Time << " milliseconds\n";
+    std::cout << "Average Queue Time: " << avgWindowQueueTime << " milliseconds\n";
+    std::cout << "Queue Time Ratio (Standard / Custom): " << avgWindowQueueTime / avgWindowMiniQueueTime << "\n";
+    std::cout << "Queue Time Ratio (Standard / Custom power of two): " << avgWindowQueueTime / avgWindowMiniQueuePow2Time << "\n";
+    if (windowSums[0] != windowSums[2] || windowSums[1] != windowSums[2]) {
+      std::cout << "Windowed queues disagree on the elements popped\n";
+    }
+  }
+
+  {
+    /* Producer thread to consumer thread */
+    constexpr std::size_t kHandOffIter{ 1000000 };
+    constexpr std::size_t kRoundTrips{ 100000 };
+
+    std::cout << "\nTwo-thread hand-off of " << kHandOffIter << " elements\n";
+    {
+      const auto startTime = startTimer();
+      miniSpscQueueHandOff(kHandOffIter);
+      const std::chrono::milliseconds elapsed = endTimer(startTime);
+      std::cout << "MiniSpscQueue: " << elapsed.count() << " milliseconds, "
+                << kHandOffIter / (elapsed.count() > 0 ? elapsed.count() : 1) << " elements/ms\n";
+    }
+    {
+      const auto startTime = startTimer();
+      lockedMiniQueueHandOff(kHandOffIter);
+      const std::chrono::milliseconds elapsed = endTimer(startTime);
+      std::cout << "MiniQueue + mutex: " << elapsed.count() << " milliseconds, "
+                << kHandOffIter / (elapsed.count() > 0 ? elapsed.count() : 1) << " elements/ms\n";
+    }
+    std::cout << "MiniSpscQueue round trip (ping-pong, " << kRoundTrips << " trips): "
+              << miniSpscQueueRoundTrip(kRoundTrips).count() << " nanoseconds average\n";
+
+    /* Producers and consumers sharing one MiniMpmcQueue, 1 up to the core count each */
+    const std::size_t cores = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() : 2;
+    std::cout << "\nMiniMpmcQueue hand-off of " << kHandOffIter << " elements\n";
+    for (std::size_t producers = 1; producers <= cores; producers *= 2)
+    {
+      for (std::size_t consumers = 1; consumers <= cores; consumers *= 2)
+      {
+        const auto startTime = startTimer();
+        miniMpmcQueueHandOff(kHandOffIter, producers, consumers);
+        const std::chrono::milliseconds elapsed = endTimer(startTime);
+        std::cout << producers << " producer(s), " << consumers << " consumer(s): "
+                  << elapsed.count() << " milliseconds, "
+                  << kHandOffIter / (elapsed.count() > 0 ? elapsed.count() : 1) << " elements/ms\n";
+      }
+    }
   }
 }
 
 std::chrono::steady_clock::time_point startTimer() {
-  auto time = std::chrono::high_resolution_clock::now();
+  auto time = std::chrono::steady_clock::now();
   return time;
 }
 
 std::chrono::milliseconds endTimer(const std::chrono::steady_clock::time_point& time) {
-  const auto endTime = std::chrono::high_resolution_clock::now();
+  const auto endTime = std::chrono::steady_clock::now();
   return std::chrono::duration_cast<std::chrono::milliseconds>(endTime - time);
   /*
   const auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - time);
@@ -207,6 +408,69 @@ void queueTest() {
   miniQueue_A.push(127);
   std::cout << miniQueue_A.front() << ' ' << miniQueue_A.back() << '\n';
 
+  // Power-of-two windowing: the default 10 rounds up to 16
+  MiniQueue<int, PowerOfTwoCapacity> miniQueue_P{};
+  for (int i{ 0 }; i < 16; ++i) {
+    miniQueue_P.push(i);
+  }
+  for (int i{ 0 }; i < 10; ++i) {
+    miniQueue_P.pop();
+  }
+  miniQueue_P.push(47); // wraps around
+  std::cout << "Expected: 10 47 7, Actual: " << miniQueue_P.front() << ' ' << miniQueue_P.back() << ' ' << miniQueue_P.size() << '\n';
+
+  // Growth test: a full, wrapped ring of 4 doubles and unwraps on the next push
+  MiniQueue<int, ExactCapacity, GrowByDoubling> miniQueue_W{ 4 };
+  for (int i{ 0 }; i < 4; ++i) {
+    miniQueue_W.push(i);
+  }
+  miniQueue_W.pop();
+  miniQueue_W.pop();
+  miniQueue_W.push(4);
+  miniQueue_W.push(5);
+  miniQueue_W.push(6); // grows
+  std::cout << "Expected: 2 6 5 8, Actual: " << miniQueue_W.front() << ' ' << miniQueue_W.back() << ' '
+            << miniQueue_W.size() << ' ' << miniQueue_W.capacity() << '\n';
+
+  // Shrink test: 100 pushes grow 16 to 128, draining to 10 halves it twice
+  MiniQueue<int, PowerOfTwoCapacity, GrowAndShrink> miniQueue_S{};
+  for (int i{ 0 }; i < 100; ++i) {
+    miniQueue_S.push(i);
+  }
+  std::cout << "Expected: 128, Actual: " << miniQueue_S.capacity() << '\n';
+  for (int i{ 0 }; i < 90; ++i) {
+    miniQueue_S.pop();
+  }
+  std::cout << "Expected: 90 99 10 32, Actual: " << miniQueue_S.front() << ' ' << miniQueue_S.back() << ' '
+            << miniQueue_S.size() << ' ' << miniQueue_S.capacity() << '\n';
+
+  // Bulk test: push_bulk wraps past the end of a ring of 5, pop_bulk drains it front first
+  MiniQueue<int> miniQueue_K{ 5 };
+  miniQueue_K.push(0);
+  miniQueue_K.push(1);
+  miniQueue_K.push(2);
+  miniQueue_K.pop();
+  miniQueue_K.pop();
+  const int bulk[]{ 3, 4, 5, 6 };
+  miniQueue_K.push_bulk(bulk);
+  std::cout << "Expected: 2 6 5, Actual: " << miniQueue_K.front() << ' ' << miniQueue_K.back() << ' '
+            << miniQueue_K.size() << '\n';
+  int out[4]{};
+  std::size_t popped = miniQueue_K.pop_bulk(std::span<int>(out, 3));
+  std::cout << "Expected: 3 2 3 4, Actual: " << popped << ' ' << out[0] << ' ' << out[1] << ' ' << out[2] << '\n';
+  popped = miniQueue_K.pop_bulk(out);
+  std::cout << "Expected: 2 5 6 1, Actual: " << popped << ' ' << out[0] << ' ' << out[1] << ' '
+            << miniQueue_K.empty() << '\n';
+  try
+  {
+    const int tooMany[6]{};
+    miniQueue_K.push_bulk(tooMany);
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cout << miniQueue_K.size() << " : " << e.what() << '\n';
+  }
+
   // Exception test
   int count{};
   MiniQueue<int> miniQueue_C{};
@@ -289,6 +553,92 @@ void queueTest() {
 
 }
 
+void spscQueueTest()
+{
+  MiniSpscQueue<int> spscQueue{ 3 };
+
+  std::cout << "SPSC Queue\n";
+  std::cout << "Expected: 1, Actual: " << spscQueue.empty() << '\n';
+  std::cout << "Expected: 3, Actual: " << spscQueue.capacity() << '\n';
+
+  // Fill, wrap around and drain on one thread
+  for (int i{ 0 }; i < 3; ++i) {
+    spscQueue.push(i);
+  }
+  std::cout << "Expected: 0, Actual: " << spscQueue.try_push(3) << '\n';
+  std::cout << "Expected: 0, Actual: " << spscQueue.front() << '\n';
+  spscQueue.pop();
+  spscQueue.push(3);
+  std::cout << "Expected: 3, Actual: " << spscQueue.size() << '\n';
+
+  int value{};
+  std::cout << "Expected: 1 2 3, Actual:";
+  while (spscQueue.try_pop(value)) {
+    std::cout << ' ' << value;
+  }
+  std::cout << '\n';
+
+  try
+  {
+    spscQueue.pop();
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cout << spscQueue.size() << " : " << e.what() << '\n';
+  }
+
+  // Two threads: everything arrives, in order
+  miniSpscQueueHandOff(100000);
+  std::cout << "Hand-off of 100000 elements in order\n\n";
+}
+
+void mpmcQueueTest()
+{
+  MiniMpmcQueue<int> mpmcQueue{ 3 };
+
+  std::cout << "MPMC Queue\n";
+  std::cout << "Expected: 1, Actual: " << mpmcQueue.empty() << '\n';
+  std::cout << "Expected: 3, Actual: " << mpmcQueue.capacity() << '\n';
+
+  for (int i{ 0 }; i < 3; ++i) {
+    mpmcQueue.push(i);
+  }
+  std::cout << "Expected: 0, Actual: " << mpmcQueue.try_push(3) << '\n';
+  std::cout << "Expected: 3, Actual: " << mpmcQueue.size() << '\n';
+
+  // Overflow and underflow throw like MiniQueue
+  try
+  {
+    mpmcQueue.push(3);
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cout << mpmcQueue.size() << " : " << e.what() << '\n';
+  }
+
+  int value{};
+  mpmcQueue.pop(value);
+  mpmcQueue.push(3);
+  std::cout << "Expected: 1 2 3, Actual:";
+  while (mpmcQueue.try_pop(value)) {
+    std::cout << ' ' << value;
+  }
+  std::cout << '\n';
+
+  try
+  {
+    mpmcQueue.pop(value);
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cout << mpmcQueue.size() << " : " << e.what() << '\n';
+  }
+
+  // Every element arrives exactly once across threads
+  miniMpmcQueueHandOff(100000, 3, 2);
+  std::cout << "Hand-off of 100000 elements from 3 producers to 2 consumers\n\n";
+}
+
 void stackTest()
 {
   constexpr int n{ 10 };
@@ -333,6 +683,42 @@ void stackTest()
   std::cout << "Expected: 1, Actual: " << ministack_B.empty() << '\n';
   std::cout << "Expected: 0, Actual: " << ministack_B.size() << '\n';
 
+  // Growth test: 100 pushes double 10 up to 160, 95 pops halve it back to 10
+  std::cout << "Growth\n";
+  MiniStack<int, GrowAndShrink> ministack_G{};
+  for (int i{ 0 }; i < 100; ++i)
+  {
+    ministack_G.push(i);
+  }
+  std::cout << "Expected: 100 160 99, Actual: " << ministack_G.size() << ' ' << ministack_G.capacity() << ' '
+            << ministack_G.top() << '\n';
+  for (int i{ 0 }; i < 95; ++i)
+  {
+    ministack_G.pop();
+  }
+  std::cout << "Expected: 5 10 4, Actual: " << ministack_G.size() << ' ' << ministack_G.capacity() << ' '
+            << ministack_G.top() << '\n';
+
+  // Bulk test: pop_bulk hands elements back top first
+  std::cout << "Bulk\n";
+  MiniStack<int> ministack_K{ 4 };
+  const int bulk[]{ 1, 2, 3 };
+  ministack_K.push_bulk(bulk);
+  std::cout << "Expected: 3 3, Actual: " << ministack_K.size() << ' ' << ministack_K.top() << '\n';
+  int out[2]{};
+  const std::size_t popped = ministack_K.pop_bulk(out);
+  std::cout << "Expected: 2 3 2 1, Actual: " << popped << ' ' << out[0] << ' ' << out[1] << ' '
+            << ministack_K.top() << '\n';
+  try
+  {
+    const int tooMany[4]{};
+    ministack_K.push_bulk(tooMany);
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cout << ministack_K.size() << " : " << e.what() << '\n';
+  }
+
   // Exception test
   int count{};
   try
@@ -384,6 +770,76 @@ void miniStackPushPops(const std::size_t iterations)
   }
 }
 
+/* Starts from the default capacity, so the stack doubles its way up to
+   iterations and halves its way back down */
+void miniStackGrowPushPops(const std::size_t iterations)
+{
+  MiniStack<int, GrowAndShrink> ministack;
+  for (int i = 0; ministack.size() < iterations; ++i)
+  {
+    ministack.push(i);
+  }
+  for (int i = 0; !ministack.empty(); ++i)
+  {
+    ministack.pop();
+  }
+}
+
+/* Moves iterations elements through in batches of 64 staged in a buffer,
+   the way a burst of messages would arrive: one push_bulk/pop_bulk per
+   batch if bulk, otherwise one push/pop per element. Returns the sum of
+   the elements popped */
+std::uint64_t miniStackBatchPushPops(const std::size_t iterations, const bool bulk)
+{
+  MiniStack<int> ministack(iterations);
+  std::array<int, 64> batch{};
+  int next = 0;
+  while (ministack.size() < iterations)
+  {
+    const std::size_t count = std::min(batch.size(), iterations - ministack.size());
+    for (std::size_t j = 0; j < count; ++j)
+    {
+      batch[j] = next++;
+    }
+
+    if (bulk)
+    {
+      ministack.push_bulk(std::span<const int>(batch).first(count));
+    }
+    else
+    {
+      for (std::size_t j = 0; j < count; ++j)
+      {
+        ministack.push(batch[j]);
+      }
+    }
+  }
+
+  std::uint64_t sum{ 0 };
+  while (!ministack.empty())
+  {
+    std::size_t count = 0;
+    if (bulk)
+    {
+      count = ministack.pop_bulk(batch);
+    }
+    else
+    {
+      for (; count < batch.size() && !ministack.empty(); ++count)
+      {
+        batch[count] = ministack.top();
+        ministack.pop();
+      }
+    }
+
+    for (std::size_t j = 0; j < count; ++j)
+    {
+      sum += batch[j];
+    }
+  }
+  return sum;
+}
+
 void stackPushPops(const std::size_t iterations)
 {
   std::stack<int> stack;
@@ -397,30 +853,298 @@ void stackPushPops(const std::size_t iterations)
   }
 }
 
-void miniQueuePushPops(const std::size_t iterations)
+/* Pushes 0 .. iterations - 1 onto an empty queue, then pops them all;
+   returns the sum of the elements popped */
+template <typename Queue>
+std::uint64_t fillAndDrain(Queue& queue, const std::size_t iterations)
 {
-  MiniQueue<int> miniQueue(iterations);
+  for (int i = 0; queue.size() < iterations; ++i)
+  {
+    queue.push(i);
+  }
+
+  std::uint64_t sum{ 0 };
+  while (!queue.empty())
+  {
+    sum += queue.front();
+    queue.pop();
+  }
+  return sum;
+}
+
+/* Starts from the default capacity, so the queue doubles its way up to
+   iterations and halves its way back down */
+std::uint64_t miniQueueGrowPushPops(const std::size_t iterations)
+{
+  MiniQueue<int, ExactCapacity, GrowAndShrink> miniQueue;
   for (int i = 0; miniQueue.size() < iterations; ++i)
   {
     miniQueue.push(i);
   }
 
-  for (int i = 0; !miniQueue.empty(); ++i)
+  std::uint64_t sum{ 0 };
+  while (!miniQueue.empty())
   {
+    sum += miniQueue.front();
     miniQueue.pop();
   }
+  return sum;
 }
 
-void queuePushPops(const std::size_t iterations)
+/* Moves iterations elements through in batches of 64 staged in a buffer,
+   the way a burst of messages would arrive: one push_bulk/pop_bulk per
+   batch if bulk, otherwise one push/pop per element. Returns the sum of
+   the elements popped */
+std::uint64_t miniQueueBatchPushPops(const std::size_t iterations, const bool bulk)
 {
-  std::queue<int> queue;
-  for (int i = 0; queue.size() < iterations; ++i)
+  MiniQueue<int> miniQueue(iterations);
+  std::array<int, 64> batch{};
+  int next = 0;
+  while (miniQueue.size() < iterations)
+  {
+    const std::size_t count = std::min(batch.size(), iterations - miniQueue.size());
+    for (std::size_t j = 0; j < count; ++j)
+    {
+      batch[j] = next++;
+    }
+
+    if (bulk)
+    {
+      miniQueue.push_bulk(std::span<const int>(batch).first(count));
+    }
+    else
+    {
+      for (std::size_t j = 0; j < count; ++j)
+      {
+        miniQueue.push(batch[j]);
+      }
+    }
+  }
+
+  std::uint64_t sum{ 0 };
+  while (!miniQueue.empty())
+  {
+    std::size_t count = 0;
+    if (bulk)
+    {
+      count = miniQueue.pop_bulk(batch);
+    }
+    else
+    {
+      for (; count < batch.size() && !miniQueue.empty(); ++count)
+      {
+        batch[count] = miniQueue.front();
+        miniQueue.pop();
+      }
+    }
+
+    for (std::size_t j = 0; j < count; ++j)
+    {
+      sum += batch[j];
+    }
+  }
+  return sum;
+}
+
+/* Keeps 500 elements queued while iterations more pass through; returns
+   the sum of the fronts seen so the loop cannot be optimized out */
+template <typename Queue>
+std::uint64_t windowPushPops(Queue& queue, const std::size_t iterations)
+{
+  for (int i = 0; i < 500; ++i)
   {
     queue.push(i);
   }
 
-  for (int i = 0; !queue.empty(); ++i)
+  std::uint64_t sum{ 0 };
+  for (std::size_t i = 0; i < iterations; ++i)
   {
+    queue.push(static_cast<int>(i));
+    sum += queue.front();
     queue.pop();
   }
+  return sum;
+}
+
+std::uint64_t miniQueueWindowPushPops(const std::size_t iterations)
+{
+  MiniQueue<int> miniQueue(1000);
+  return windowPushPops(miniQueue, iterations);
+}
+
+std::uint64_t miniQueuePow2WindowPushPops(const std::size_t iterations)
+{
+  MiniQueue<int, PowerOfTwoCapacity> miniQueue(1000);
+  return windowPushPops(miniQueue, iterations);
+}
+
+std::uint64_t queueWindowPushPops(const std::size_t iterations)
+{
+  std::queue<int> queue;
+  return windowPushPops(queue, iterations);
+}
+
+/* The producer pushes 0 .. iterations - 1 through a small ring while the
+   consumer pops them; each side yields when the ring is full or empty */
+void miniSpscQueueHandOff(const std::size_t iterations)
+{
+  MiniSpscQueue<std::size_t> miniQueue(1024);
+
+  std::thread producer([&miniQueue, iterations]() {
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      while (!miniQueue.try_push(i))
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::size_t expected = 0;
+  std::size_t value{};
+  while (expected < iterations)
+  {
+    if (miniQueue.try_pop(value))
+    {
+      if (value != expected)
+      {
+        throw std::runtime_error("MiniSpscQueue delivered out of order");
+      }
+      ++expected;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+}
+
+/* The same hand-off through a MiniQueue guarded by a mutex */
+void lockedMiniQueueHandOff(const std::size_t iterations)
+{
+  MiniQueue<std::size_t> miniQueue(1024);
+  std::mutex lock;
+
+  std::thread producer([&miniQueue, &lock, iterations]() {
+    for (std::size_t i = 0; i < iterations;)
+    {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (miniQueue.size() < 1024)
+        {
+          miniQueue.push(i++);
+          continue;
+        }
+      }
+      std::this_thread::yield();
+    }
+  });
+
+  std::size_t expected = 0;
+  while (expected < iterations)
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      if (!miniQueue.empty())
+      {
+        if (miniQueue.front() != expected)
+        {
+          throw std::runtime_error("MiniQueue delivered out of order");
+        }
+        miniQueue.pop();
+        ++expected;
+        continue;
+      }
+    }
+    std::this_thread::yield();
+  }
+  producer.join();
+}
+
+/* Latency: a value goes out on one queue and is echoed back on another */
+std::chrono::nanoseconds miniSpscQueueRoundTrip(const std::size_t iterations)
+{
+  MiniSpscQueue<std::size_t> ping(16);
+  MiniSpscQueue<std::size_t> pong(16);
+
+  std::thread echo([&ping, &pong, iterations]() {
+    std::size_t value{};
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      while (!ping.try_pop(value))
+      {
+        std::this_thread::yield();
+      }
+      while (!pong.try_push(value))
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  const auto start = std::chrono::steady_clock::now();
+  std::size_t value{};
+  for (std::size_t i = 0; i < iterations; ++i)
+  {
+    ping.push(i);
+    while (!pong.try_pop(value))
+    {
+      std::this_thread::yield();
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  echo.join();
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) / iterations;
+}
+
+/* Each producer pushes its share of 0 .. iterations - 1 with push_wait and
+   each consumer pops with try_pop until everything has been taken; the
+   total of what was popped confirms nothing was lost or doubled */
+void miniMpmcQueueHandOff(const std::size_t iterations, const std::size_t producers, const std::size_t consumers)
+{
+  MiniMpmcQueue<std::size_t> miniQueue(1024);
+  std::atomic<std::size_t> taken{ 0 };
+  std::atomic<std::size_t> total{ 0 };
+
+  std::vector<std::thread> threads;
+  for (std::size_t p = 0; p < producers; ++p)
+  {
+    threads.emplace_back([&miniQueue, iterations, producers, p]() {
+      for (std::size_t i = p; i < iterations; i += producers)
+      {
+        miniQueue.push_wait(i);
+      }
+    });
+  }
+  for (std::size_t c = 0; c < consumers; ++c)
+  {
+    threads.emplace_back([&miniQueue, &taken, &total, iterations]() {
+      std::size_t sum = 0;
+      std::size_t value{};
+      while (taken.load(std::memory_order_relaxed) < iterations)
+      {
+        if (miniQueue.try_pop(value))
+        {
+          sum += value;
+          taken.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+      total.fetch_add(sum);
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  if (total.load() != iterations * (iterations - 1) / 2)
+  {
+    throw std::runtime_error("MiniMpmcQueue lost or repeated elements");
+  }
 }
@@ -0,0 +1,33 @@
+/***
+ * MiniGrowth
+ *
+ * Growth policies shared by MiniStack and MiniQueue.
+ *
+ * FixedSize      - the constructor-chosen capacity never changes and a
+ *                  push on a full container throws; no allocation after
+ *                  construction, for real-time use.
+ * GrowByDoubling - a push on a full container moves the elements into a
+ *                  buffer twice the size, so pushes are amortized O(1).
+ * GrowAndShrink  - grows like GrowByDoubling, and once a pop leaves the
+ *                  container a quarter full it moves the elements into a
+ *                  buffer half the size, never below the constructed
+ *                  capacity. Halving at a quarter rather than a half keeps
+ *                  a push/pop pair at the boundary from reallocating twice.
+ */
+
+#pragma once
+#ifndef MINIGROWTH_HPP_
+#define MINIGROWTH_HPP_
+
+#include <type_traits> // is_same_v
+
+struct FixedSize {};
+struct GrowByDoubling {};
+struct GrowAndShrink {};
+
+template <typename Growth>
+constexpr bool kIsGrowthPolicy = std::is_same_v<Growth, FixedSize> ||
+                                 std::is_same_v<Growth, GrowByDoubling> ||
+                                 std::is_same_v<Growth, GrowAndShrink>;
+
+#endif // MINIGROWTH_HPP_
@@ -0,0 +1,291 @@
+/***
+ * MiniMpmcQueue
+ *
+ * A multi-producer/multi-consumer bounded queue template class.
+ *
+ * The statically sized ring of MiniQueue, shared by any number of
+ * producer and consumer threads without a lock, after Dmitry Vyukov's
+ * bounded MPMC queue:
+ * https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * Every slot carries a sequence number saying whose turn it is. A slot at
+ * position `pos` is free for the producer claiming `pos` when its sequence
+ * equals `pos`, and holds an element for the consumer claiming `pos` when
+ * it equals `pos + 1`. A thread claims a position with one compare-exchange
+ * on the shared enqueue or dequeue counter, then hands the slot on by
+ * bumping its sequence (release), so producers and consumers only contend
+ * with their own kind and never on a shared element count.
+ *
+ * push/pop throw on overflow/underflow like MiniQueue, try_push/try_pop
+ * report it instead, and push_wait/pop_wait wait for room or an element.
+ *
+ * T must be nothrow copy and move assignable, as in Vyukov's queue: an
+ * element is assigned into or out of a slot after the slot is claimed,
+ * and a slot that is claimed but never handed on stops every thread that
+ * comes to it later.
+ */
+
+#pragma once
+#pragma warning(disable : 26455) // ignore default constructor noexcept
+#ifndef MINIMPMCQUEUE_HPP_
+#define MINIMPMCQUEUE_HPP_
+
+#include <atomic>    // atomic, memory_order
+#include <cstddef>   // size_t, ptrdiff_t
+#include <memory>    // unique_ptr, make_unique
+#include <stdexcept> // runtime_error
+#include <thread>    // this_thread::yield
+#include <type_traits> // is_nothrow_copy_assignable_v, is_nothrow_move_assignable_v
+#include <utility>   // move
+
+template <typename T>
+class MiniMpmcQueue
+{
+  static_assert(std::is_nothrow_copy_assignable_v<T> && std::is_nothrow_move_assignable_v<T>,
+                "MiniMpmcQueue needs T to be nothrow copy and move assignable");
+
+private:
+  constexpr static std::size_t kQueueSize{ 10 };
+  constexpr static std::size_t kCacheLine{ 64 };
+  constexpr static int kSpins{ 64 }; // busy retries before a waiting call yields
+
+  struct Slot
+  {
+    std::atomic<std::size_t> sequence;
+    T data;
+  };
+
+  std::size_t length_;    // total capacity of queue
+  std::unique_ptr<Slot[]> slots_;
+
+  alignas(kCacheLine) std::atomic<std::size_t> enqueuePos_; // next position to fill
+  alignas(kCacheLine) std::atomic<std::size_t> dequeuePos_; // next position to empty
+
+  Slot* claimPush();
+  Slot* claimPop();
+  void publishPush(Slot* slot, std::size_t pos) noexcept;
+  void publishPop(Slot* slot, std::size_t pos) noexcept;
+
+public:
+  /* Default Constructor */
+  MiniMpmcQueue(std::size_t len = 0);
+
+  MiniMpmcQueue(const MiniMpmcQueue&) = delete;
+  MiniMpmcQueue& operator=(const MiniMpmcQueue&) = delete;
+
+  /* Capacity: a snapshot while other threads are running */
+  bool empty() const noexcept;
+  std::size_t size() const noexcept;
+  std::size_t capacity() const noexcept;
+
+  /* Modifiers */
+  bool try_push(const T& t);
+  bool try_push(T&& t);
+  bool try_pop(T& out);
+
+  void push(const T& t);
+  void pop(T& out);
+
+  void push_wait(const T& t);
+  void pop_wait(T& out);
+};
+
+/* if a length has been input, use that for sizing the queue */
+template <typename T>
+MiniMpmcQueue<T>::MiniMpmcQueue(std::size_t length) :
+  length_{ length > 0 ? length : kQueueSize },
+  slots_{ std::make_unique<Slot[]>(this->length_) },
+  enqueuePos_{ 0 },
+  dequeuePos_{ 0 }
+{
+  for (std::size_t i = 0; i < length_; ++i)
+  {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+template <typename T>
+bool MiniMpmcQueue<T>::empty() const noexcept
+{
+  return size() == 0;
+}
+
+template <typename T>
+std::size_t MiniMpmcQueue<T>::size() const noexcept
+{
+  const std::size_t dequeued = dequeuePos_.load(std::memory_order_acquire);
+  const std::size_t enqueued = enqueuePos_.load(std::memory_order_acquire);
+  /* a claim in flight can put the dequeue count ahead for a moment */
+  return (enqueued > dequeued) ? enqueued - dequeued : 0;
+}
+
+template <typename T>
+std::size_t MiniMpmcQueue<T>::capacity() const noexcept
+{
+  return length_;
+}
+
+/* Claims the slot for the next push, or returns nullptr when full. On
+   success the claimed position is one behind enqueuePos_. */
+template <typename T>
+typename MiniMpmcQueue<T>::Slot* MiniMpmcQueue<T>::claimPush()
+{
+  std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Slot* slot = &slots_[pos % length_];
+    const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const std::ptrdiff_t turn = static_cast<std::ptrdiff_t>(sequence - pos);
+    if (turn == 0)
+    {
+      if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        return slot;
+      }
+    }
+    else if (turn < 0)
+    {
+      return nullptr; // the slot still holds an element from a lap ago
+    }
+    else
+    {
+      pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+template <typename T>
+typename MiniMpmcQueue<T>::Slot* MiniMpmcQueue<T>::claimPop()
+{
+  std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Slot* slot = &slots_[pos % length_];
+    const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const std::ptrdiff_t turn = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+    if (turn == 0)
+    {
+      if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        return slot;
+      }
+    }
+    else if (turn < 0)
+    {
+      return nullptr; // nothing has been pushed here yet
+    }
+    else
+    {
+      pos = dequeuePos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/* pos is the slot's sequence when it was claimed */
+template <typename T>
+void MiniMpmcQueue<T>::publishPush(Slot* slot, std::size_t pos) noexcept
+{
+  slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+template <typename T>
+void MiniMpmcQueue<T>::publishPop(Slot* slot, std::size_t pos) noexcept
+{
+  slot->sequence.store(pos + length_, std::memory_order_release);
+}
+
+template <typename T>
+bool MiniMpmcQueue<T>::try_push(const T& t)
+{
+  Slot* slot = claimPush();
+  if (slot == nullptr)
+  {
+    return false;
+  }
+  const std::size_t pos = slot->sequence.load(std::memory_order_relaxed);
+  slot->data = t;
+  publishPush(slot, pos);
+  return true;
+}
+
+template <typename T>
+bool MiniMpmcQueue<T>::try_push(T&& t)
+{
+  Slot* slot = claimPush();
+  if (slot == nullptr)
+  {
+    return false;
+  }
+  const std::size_t pos = slot->sequence.load(std::memory_order_relaxed);
+  slot->data = std::move(t);
+  publishPush(slot, pos);
+  return true;
+}
+
+template <typename T>
+bool MiniMpmcQueue<T>::try_pop(T& out)
+{
+  Slot* slot = claimPop();
+  if (slot == nullptr)
+  {
+    return false;
+  }
+  const std::size_t pos = slot->sequence.load(std::memory_order_relaxed) - 1;
+  out = std::move(slot->data);
+  publishPop(slot, pos);
+  return true;
+}
+
+template <typename T>
+void MiniMpmcQueue<T>::push(const T& t)
+{
+  if (!try_push(t))
+  {
+    throw std::runtime_error("Queue overflow in `push`");
+  }
+}
+
+template <typename T>
+void MiniMpmcQueue<T>::pop(T& out)
+{
+  if (!try_pop(out))
+  {
+    throw std::runtime_error("Queue underflow in `pop`");
+  }
+}
+
+template <typename T>
+void MiniMpmcQueue<T>::push_wait(const T& t)
+{
+  /* stop counting at kSpins, an idle waiter can retry indefinitely */
+  for (int spins = 0; !try_push(t);)
+  {
+    if (spins < kSpins)
+    {
+      ++spins;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename T>
+void MiniMpmcQueue<T>::pop_wait(T& out)
+{
+  /* stop counting at kSpins, an idle waiter can retry indefinitely */
+  for (int spins = 0; !try_pop(out);)
+  {
+    if (spins < kSpins)
+    {
+      ++spins;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+#endif // MINIMPMCQUEUE_HPP_
@@ -11,6 +11,18 @@
  * of the queue. As long as the queue elements are 
  * not maxed out, then the queue can wrap around the 
  * last index, and the queue moves in a windowed fashion.
+ *
+ * Capacity policies:
+ * ExactCapacity      - the ring holds exactly the requested number of
+ *                      elements; indices wrap with a compare at the end.
+ * PowerOfTwoCapacity - the request is rounded up to a power of two;
+ *                      `begin_` and `end_` run freely and are masked on
+ *                      access, so push/pop need no wrap branches and the
+ *                      element count is just `end_ - begin_`.
+ *
+ * Growth policies (MiniGrowth.hpp): FixedSize throws on overflow, while
+ * GrowByDoubling and GrowAndShrink move the queue into a larger (or
+ * smaller) buffer, unwrapping it so the front lands at index 0.
  */
 
 #pragma once
@@ -18,22 +30,40 @@
 #ifndef MINIQUEUE_HPP_
 #define MINIQUEUE_HPP_
 
-#include <algorithm> // copy, move
-#include <memory>    // unique_ptr, make_unique
+#include <algorithm> // copy, move, min
+#include <memory>    // unique_ptr, make_unique_for_overwrite
+#include <span>      // span
 #include <stdexcept> // runtime_error
+#include <type_traits> // is_same_v
+#include <bit>       // bit_ceil
+#include "MiniGrowth.hpp"
+
+struct ExactCapacity {};
+struct PowerOfTwoCapacity {};
 
-template <typename T>
+template <typename T, typename Capacity = ExactCapacity, typename Growth = FixedSize>
 class MiniQueue
 {
+  static_assert(std::is_same_v<Capacity, ExactCapacity> || std::is_same_v<Capacity, PowerOfTwoCapacity>,
+                "MiniQueue Capacity must be ExactCapacity or PowerOfTwoCapacity");
+  static_assert(kIsGrowthPolicy<Growth>, "MiniQueue Growth must be FixedSize, GrowByDoubling or GrowAndShrink");
+
 private:
   constexpr static std::size_t kQueueSize{ 10 };
+  constexpr static bool kPowerOfTwo = std::is_same_v<Capacity, PowerOfTwoCapacity>;
+
+  static std::size_t capacityFor(std::size_t length) noexcept;
+  std::size_t slot(std::size_t index) const noexcept;
+  void relocate(std::size_t length);
+  void shrinkIfSparse();
 
   std::size_t length_;    // total capacity or size of queue
+  std::size_t minLength_; // constructed capacity, the floor for GrowAndShrink
   std::unique_ptr<T[]> elements_;
   
-  std::size_t counter_;   // number of elements
-  std::size_t begin_;     // index of next element to leave queue
-  std::size_t end_;       // index of last element + 1
+  std::size_t counter_;   // number of elements (ExactCapacity only)
+  std::size_t begin_;     // index of next element to leave queue (free-running if PowerOfTwo)
+  std::size_t end_;       // index of last element + 1 (free-running if PowerOfTwo)
 
 public:
   /* Default Constructor */
@@ -42,11 +72,16 @@ public:
   /* Capacity */
   bool empty() const noexcept;
   std::size_t size() const noexcept;
+  std::size_t capacity() const noexcept;
 
   /* Modifiers */
   void push(const T& t);
   void pop();
 
+  /* Batched: one capacity check, at most two contiguous copies */
+  void push_bulk(std::span<const T> values);
+  std::size_t pop_bulk(std::span<T> out);
+
   /* Access */
   T& front() const;
   T& back() const;
@@ -60,33 +95,99 @@ public:
   MiniQueue& operator=(MiniQueue&& other) noexcept;
 };
 
-/* if a length has been input, use that for sizing the queue */
-template <typename T>
-MiniQueue<T>::MiniQueue(std::size_t length) : 
-  length_{ length > 0 ? length : kQueueSize },
-  elements_{ std::make_unique<T[]>(this->length_) },
+/* PowerOfTwoCapacity rounds the requested length up */
+template <typename T, typename Capacity, typename Growth>
+std::size_t MiniQueue<T, Capacity, Growth>::capacityFor(std::size_t length) noexcept
+{
+  if constexpr (kPowerOfTwo) {
+    return std::bit_ceil(length);
+  }
+  else {
+    return length;
+  }
+}
+
+/* Maps a position of up to begin_ + length_ onto the buffer */
+template <typename T, typename Capacity, typename Growth>
+inline std::size_t MiniQueue<T, Capacity, Growth>::slot(std::size_t index) const noexcept
+{
+  if constexpr (kPowerOfTwo) {
+    return index & (length_ - 1);
+  }
+  else {
+    return (index < length_) ? index : index - length_;
+  }
+}
+
+/* if a length has been input, use that for sizing the queue; slots are
+   left default-initialized since each is assigned before it is read */
+template <typename T, typename Capacity, typename Growth>
+MiniQueue<T, Capacity, Growth>::MiniQueue(std::size_t length) : 
+  length_{ capacityFor(length > 0 ? length : kQueueSize) },
+  minLength_{ this->length_ },
+  elements_{ std::make_unique_for_overwrite<T[]>(this->length_) },
   counter_{ 0 },
   begin_{ 0 },
   end_{ 0 } {}
 
-template <typename T>
-bool MiniQueue<T>::empty() const noexcept
+template <typename T, typename Capacity, typename Growth>
+inline bool MiniQueue<T, Capacity, Growth>::empty() const noexcept
 {
-  return (counter_ == 0);
+  return (size() == 0);
 }
 
-template <typename T>
-std::size_t MiniQueue<T>::size() const noexcept
+template <typename T, typename Capacity, typename Growth>
+inline std::size_t MiniQueue<T, Capacity, Growth>::size() const noexcept
 {
-  return counter_;
+  if constexpr (kPowerOfTwo) {
+    return end_ - begin_;
+  }
+  else {
+    return counter_;
+  }
 }
 
-template <typename T>
-void MiniQueue<T>::push(const T& t)
+template <typename T, typename Capacity, typename Growth>
+inline std::size_t MiniQueue<T, Capacity, Growth>::capacity() const noexcept
 {
-  if (counter_ >= length_)
+  return length_;
+}
+
+/* Moves the elements into a new buffer of length slots, front first */
+template <typename T, typename Capacity, typename Growth>
+void MiniQueue<T, Capacity, Growth>::relocate(std::size_t length)
+{
+  std::unique_ptr<T[]> elements = std::make_unique_for_overwrite<T[]>(length);
+  const std::size_t count = size();
+  for (std::size_t i = 0; i < count; ++i) {
+    elements[i] = std::move(elements_[slot(begin_ + i)]);
+  }
+
+  elements_ = std::move(elements);
+  length_ = length;
+  begin_ = 0;
+  end_ = count;
+}
+
+template <typename T, typename Capacity, typename Growth>
+inline void MiniQueue<T, Capacity, Growth>::push(const T& t)
+{
+  if (size() >= length_)
   {
-    throw std::runtime_error("Queue overflow in `push`");
+    if constexpr (std::is_same_v<Growth, FixedSize>) {
+      throw std::runtime_error("Queue overflow in `push`");
+    }
+    else {
+      const T value(t); // t may be an element of this queue
+      relocate(length_ > 0 ? length_ * 2 : capacityFor(kQueueSize));
+      push(value);
+      return;
+    }
+  }
+
+  if constexpr (kPowerOfTwo) {
+    elements_[end_++ & (length_ - 1)] = t;
+    return;
   }
   
   /* loop back around to the start of the queue after reaching the end */
@@ -98,25 +199,32 @@ void MiniQueue<T>::push(const T& t)
   ++counter_;
 }
 
-template <typename T>
-T& MiniQueue<T>::front() const
+template <typename T, typename Capacity, typename Growth>
+inline T& MiniQueue<T, Capacity, Growth>::front() const
 {
   if (empty())
   {
     throw std::runtime_error("Queue underflow in `front`");
   }
 
+  if constexpr (kPowerOfTwo) {
+    return elements_[begin_ & (length_ - 1)];
+  }
   return elements_[begin_];
 }
 
-template <typename T>
-T& MiniQueue<T>::back() const
+template <typename T, typename Capacity, typename Growth>
+inline T& MiniQueue<T, Capacity, Growth>::back() const
 {
   if (empty())
   {
     throw std::runtime_error("Queue underflow in `back`");
   }
 
+  if constexpr (kPowerOfTwo) {
+    return elements_[(end_ - 1) & (length_ - 1)];
+  }
+
   /* if the last element is at the end of the structure, wrap the
      index access to the end of the structure */
   if (end_ == 0) {
@@ -126,62 +234,166 @@ T& MiniQueue<T>::back() const
   return elements_[end_ - 1];
 }
 
-template <typename T>
-void MiniQueue<T>::pop()
+template <typename T, typename Capacity, typename Growth>
+inline void MiniQueue<T, Capacity, Growth>::pop()
 {
   if (empty())
   {
     throw std::runtime_error("Queue underflow in `pop`");
   }
 
+  if constexpr (kPowerOfTwo) {
+    ++begin_;
+  }
   /* there is only a single element left, reset the queue */
-  if ((begin_ + 1 == end_) || (begin_ + 1 >= length_ && end_ == 0)) {
+  else if ((begin_ + 1 == end_) || (begin_ + 1 >= length_ && end_ == 0)) {
     counter_ = begin_ = end_ = 0;
+  }
+  else {
+    /* wrap begin back around to the beginning */
+    if (begin_ + 1 >= length_) {
+      begin_ = 0;
+    }
+    else {
+      begin_ += 1;
+    }
+
+    --counter_;
+  }
+
+  shrinkIfSparse();
+}
+
+/* GrowAndShrink: halves the buffer while it is at most a quarter full */
+template <typename T, typename Capacity, typename Growth>
+inline void MiniQueue<T, Capacity, Growth>::shrinkIfSparse()
+{
+  if constexpr (std::is_same_v<Growth, GrowAndShrink>) {
+    std::size_t length = length_;
+    while (size() * 4 <= length && length / 2 >= minLength_) {
+      length /= 2;
+    }
+
+    if (length != length_) {
+      relocate(length);
+    }
+  }
+}
+
+/* Appends values in order; values must not refer into this queue */
+template <typename T, typename Capacity, typename Growth>
+void MiniQueue<T, Capacity, Growth>::push_bulk(std::span<const T> values)
+{
+  const std::size_t count = values.size();
+  if (count > length_ - size())
+  {
+    if constexpr (std::is_same_v<Growth, FixedSize>) {
+      throw std::runtime_error("Queue overflow in `push_bulk`");
+    }
+    else {
+      std::size_t length = length_ > 0 ? length_ : capacityFor(kQueueSize);
+      while (length - size() < count) {
+        length *= 2;
+      }
+      relocate(length);
+    }
+  }
+
+  if (count == 0) {
     return;
   }
 
-  /* wrap begin back around to the beginning */
-  if (begin_ + 1 >= length_) {
-    begin_ = 0;
+  /* the free slots run from the tail to the end of the buffer, then
+     continue from the start */
+  std::size_t tail;
+  if constexpr (kPowerOfTwo) {
+    tail = end_ & (length_ - 1);
   }
   else {
-    begin_ += 1;
+    tail = (end_ >= length_) ? 0 : end_;
   }
 
-  --counter_;
+  const std::size_t first = std::min(count, length_ - tail);
+  std::copy(values.begin(), values.begin() + first, elements_.get() + tail);
+  std::copy(values.begin() + first, values.end(), elements_.get());
+
+  if constexpr (kPowerOfTwo) {
+    end_ += count;
+  }
+  else {
+    end_ = (tail + count > length_) ? tail + count - length_ : tail + count;
+    counter_ += count;
+  }
+}
+
+/* Pops up to out.size() elements, front first, and returns how many */
+template <typename T, typename Capacity, typename Growth>
+std::size_t MiniQueue<T, Capacity, Growth>::pop_bulk(std::span<T> out)
+{
+  const std::size_t count = std::min(out.size(), size());
+  if (count == 0) {
+    return 0;
+  }
+
+  const std::size_t head = slot(begin_);
+  const std::size_t first = std::min(count, length_ - head);
+  std::move(elements_.get() + head, elements_.get() + head + first, out.begin());
+  std::move(elements_.get(), elements_.get() + (count - first), out.begin() + first);
+
+  if constexpr (kPowerOfTwo) {
+    begin_ += count;
+  }
+  /* the queue was emptied, reset it like pop does */
+  else if (count == counter_) {
+    counter_ = begin_ = end_ = 0;
+  }
+  else {
+    begin_ = slot(begin_ + count);
+    counter_ -= count;
+  }
+
+  shrinkIfSparse();
+  return count;
 }
 
 /* Copy constructor */
-template <typename T>
-MiniQueue<T>::MiniQueue(const MiniQueue& other) :
+template <typename T, typename Capacity, typename Growth>
+MiniQueue<T, Capacity, Growth>::MiniQueue(const MiniQueue& other) :
   length_(other.length_),
-  elements_(std::make_unique<T[]>(other.length_)),
+  minLength_(other.minLength_),
+  elements_(std::make_unique_for_overwrite<T[]>(other.length_)),
   counter_(other.counter_),
   begin_(other.begin_),
   end_(other.end_)
 {
-  std::copy(&other.elements_[0], &other.elements_[other.length_], &elements_[0]);
+  for (std::size_t i = 0; i < size(); ++i) {
+    elements_[slot(begin_ + i)] = other.elements_[slot(begin_ + i)];
+  }
 }
 
 /* Copy assignment operator */
-template <typename T>
-MiniQueue<T>& MiniQueue<T>::operator=(const MiniQueue& other)
+template <typename T, typename Capacity, typename Growth>
+MiniQueue<T, Capacity, Growth>& MiniQueue<T, Capacity, Growth>::operator=(const MiniQueue& other)
 {
   if (this != &other) {
-    elements_ = std::make_unique<T[]>(other.length_);
-    std::copy(&other.elements_[0], &other.elements_[other.length_], &elements_[0]);
+    elements_ = std::make_unique_for_overwrite<T[]>(other.length_);
     length_ = other.length_;
+    minLength_ = other.minLength_;
     counter_ = other.counter_;
     begin_ = other.begin_;
     end_ = other.end_;
+    for (std::size_t i = 0; i < size(); ++i) {
+      elements_[slot(begin_ + i)] = other.elements_[slot(begin_ + i)];
+    }
   }
   return *this;
 }
 
 /* Move constructor */
-template <typename T>
-MiniQueue<T>::MiniQueue(MiniQueue&& other) noexcept :
+template <typename T, typename Capacity, typename Growth>
+MiniQueue<T, Capacity, Growth>::MiniQueue(MiniQueue&& other) noexcept :
   length_(other.length_),
+  minLength_(other.minLength_),
   elements_(std::move(other.elements_)),
   counter_(other.counter_),
   begin_(other.begin_),
@@ -194,11 +406,12 @@ MiniQueue<T>::MiniQueue(MiniQueue&& other) noexcept :
 }
 
 /* Move assignment operator */
-template <typename T>
-MiniQueue<T>& MiniQueue<T>::operator=(MiniQueue&& other) noexcept
+template <typename T, typename Capacity, typename Growth>
+MiniQueue<T, Capacity, Growth>& MiniQueue<T, Capacity, Growth>::operator=(MiniQueue&& other) noexcept
 {
   if (this != &other) {
     length_ = other.length_;
+    minLength_ = other.minLength_;
     elements_ = std::move(other.elements_);
     counter_ = other.counter_;
     begin_ = other.begin_;
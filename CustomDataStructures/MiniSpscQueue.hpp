@@ -0,0 +1,209 @@
+/***
+ * MiniSpscQueue
+ *
+ * A single-producer/single-consumer lock-free queue template class.
+ *
+ * The same statically sized circular buffer as MiniQueue, for handing
+ * elements from one producer thread to one consumer thread without a lock.
+ * Only the producer writes `tail_` and only the consumer writes `head_`;
+ * each publishes its index with a release store and reads the other's with
+ * an acquire load, so an element is fully written before it can be seen.
+ *
+ * The two indices live on separate cache lines so the threads do not
+ * invalidate each other's line on every operation, and each side keeps a
+ * cached copy of the opposite index, reloading it only when the cached
+ * value says the queue is full (producer) or empty (consumer).
+ *
+ * One slot is left unused so that full and empty can be told apart from
+ * the two indices alone.
+ */
+
+#pragma once
+#pragma warning(disable : 26455) // ignore default constructor noexcept
+#ifndef MINISPSCQUEUE_HPP_
+#define MINISPSCQUEUE_HPP_
+
+#include <atomic>    // atomic, memory_order
+#include <cstddef>   // size_t
+#include <memory>    // unique_ptr, make_unique
+#include <stdexcept> // runtime_error
+#include <utility>   // move
+
+template <typename T>
+class MiniSpscQueue
+{
+private:
+  constexpr static std::size_t kQueueSize{ 10 };
+  constexpr static std::size_t kCacheLine{ 64 };
+
+  std::size_t slots_;     // capacity + 1
+  std::unique_ptr<T[]> elements_;
+
+  /* Consumer side */
+  alignas(kCacheLine) std::atomic<std::size_t> head_; // index of next element to leave queue
+  std::size_t tailCache_;                               // consumer's last view of tail_
+
+  /* Producer side */
+  alignas(kCacheLine) std::atomic<std::size_t> tail_; // index of last element + 1
+  std::size_t headCache_;                               // producer's last view of head_
+  // sizeof rounds up to the alignment, so nothing else shares this line
+
+  std::size_t next(std::size_t index) const noexcept;
+
+public:
+  /* Default Constructor */
+  MiniSpscQueue(std::size_t len = 0);
+
+  MiniSpscQueue(const MiniSpscQueue&) = delete;
+  MiniSpscQueue& operator=(const MiniSpscQueue&) = delete;
+
+  /* Capacity: exact from either thread only while the other is idle */
+  bool empty() const noexcept;
+  std::size_t size() const noexcept;
+  std::size_t capacity() const noexcept;
+
+  /* Producer */
+  bool try_push(const T& t);
+  bool try_push(T&& t);
+  void push(const T& t);
+
+  /* Consumer */
+  bool try_pop(T& out);
+  void pop();
+  T& front();
+};
+
+/* if a length has been input, use that for sizing the queue */
+template <typename T>
+MiniSpscQueue<T>::MiniSpscQueue(std::size_t length) :
+  slots_{ (length > 0 ? length : kQueueSize) + 1 },
+  elements_{ std::make_unique<T[]>(this->slots_) },
+  head_{ 0 },
+  tailCache_{ 0 },
+  tail_{ 0 },
+  headCache_{ 0 } {}
+
+template <typename T>
+std::size_t MiniSpscQueue<T>::next(std::size_t index) const noexcept
+{
+  return (index + 1 == slots_) ? 0 : index + 1;
+}
+
+template <typename T>
+bool MiniSpscQueue<T>::empty() const noexcept
+{
+  return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+}
+
+template <typename T>
+std::size_t MiniSpscQueue<T>::size() const noexcept
+{
+  const std::size_t head = head_.load(std::memory_order_acquire);
+  const std::size_t tail = tail_.load(std::memory_order_acquire);
+  return (tail >= head) ? tail - head : tail + slots_ - head;
+}
+
+template <typename T>
+std::size_t MiniSpscQueue<T>::capacity() const noexcept
+{
+  return slots_ - 1;
+}
+
+template <typename T>
+bool MiniSpscQueue<T>::try_push(const T& t)
+{
+  const std::size_t tail = tail_.load(std::memory_order_relaxed);
+  const std::size_t nextTail = next(tail);
+  if (nextTail == headCache_)
+  {
+    headCache_ = head_.load(std::memory_order_acquire);
+    if (nextTail == headCache_)
+    {
+      return false;
+    }
+  }
+
+  elements_[tail] = t;
+  tail_.store(nextTail, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+bool MiniSpscQueue<T>::try_push(T&& t)
+{
+  const std::size_t tail = tail_.load(std::memory_order_relaxed);
+  const std::size_t nextTail = next(tail);
+  if (nextTail == headCache_)
+  {
+    headCache_ = head_.load(std::memory_order_acquire);
+    if (nextTail == headCache_)
+    {
+      return false;
+    }
+  }
+
+  elements_[tail] = std::move(t);
+  tail_.store(nextTail, std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+void MiniSpscQueue<T>::push(const T& t)
+{
+  if (!try_push(t))
+  {
+    throw std::runtime_error("Queue overflow in `push`");
+  }
+}
+
+template <typename T>
+bool MiniSpscQueue<T>::try_pop(T& out)
+{
+  const std::size_t head = head_.load(std::memory_order_relaxed);
+  if (head == tailCache_)
+  {
+    tailCache_ = tail_.load(std::memory_order_acquire);
+    if (head == tailCache_)
+    {
+      return false;
+    }
+  }
+
+  out = std::move(elements_[head]);
+  head_.store(next(head), std::memory_order_release);
+  return true;
+}
+
+template <typename T>
+T& MiniSpscQueue<T>::front()
+{
+  const std::size_t head = head_.load(std::memory_order_relaxed);
+  if (head == tailCache_)
+  {
+    tailCache_ = tail_.load(std::memory_order_acquire);
+    if (head == tailCache_)
+    {
+      throw std::runtime_error("Queue underflow in `front`");
+    }
+  }
+
+  return elements_[head];
+}
+
+template <typename T>
+void MiniSpscQueue<T>::pop()
+{
+  const std::size_t head = head_.load(std::memory_order_relaxed);
+  if (head == tailCache_)
+  {
+    tailCache_ = tail_.load(std::memory_order_acquire);
+    if (head == tailCache_)
+    {
+      throw std::runtime_error("Queue underflow in `pop`");
+    }
+  }
+
+  head_.store(next(head), std::memory_order_release);
+}
+
+#endif // MINISPSCQUEUE_HPP_
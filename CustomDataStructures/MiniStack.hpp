@@ -5,6 +5,10 @@
  *
  * The objective is to define a statically sized
  * stack, that models a full stack structure.
+ *
+ * With a GrowByDoubling or GrowAndShrink policy (MiniGrowth.hpp) the
+ * stack instead moves into a buffer twice the size when full, and with
+ * GrowAndShrink into one half the size once a quarter full.
  */
 
 #pragma once
@@ -12,19 +16,31 @@
 #ifndef MINISTACK_HPP_
 #define MINISTACK_HPP_
 
+#include <algorithm> // copy, move, min
+#include <iterator>  // make_reverse_iterator
 #include <memory>    // unique_ptr, make_unique
+#include <span>      // span
 #include <stdexcept> // runtime_error
+#include <type_traits> // is_same_v
+#include <utility>   // move
+#include "MiniGrowth.hpp"
 
-template <typename T>
+template <typename T, typename Growth = FixedSize>
 class MiniStack
 {
+  static_assert(kIsGrowthPolicy<Growth>, "MiniStack Growth must be FixedSize, GrowByDoubling or GrowAndShrink");
+
 private:
   constexpr static std::size_t kStackSize{10};
 
   std::size_t length;
+  std::size_t minLength; // constructed capacity, the floor for GrowAndShrink
   std::size_t counter;
   std::unique_ptr<T[]> elements;
 
+  void relocate(std::size_t len);
+  void shrinkIfSparse();
+
 public:
   // Default Constructor
   MiniStack(std::size_t len = 0);
@@ -32,45 +48,80 @@ public:
   // Capacity
   bool empty() const noexcept;
   std::size_t size() const noexcept;
+  std::size_t capacity() const noexcept;
 
   // Modifiers
   void push(const T &t);
   void pop();
 
+  // Batched: one capacity check, one contiguous copy
+  void push_bulk(std::span<const T> values);
+  std::size_t pop_bulk(std::span<T> out);
+
   // Access
   T &top() const;
 };
 
-template <typename T>
-MiniStack<T>::MiniStack(std::size_t len) : length{len > 0 ? len : kStackSize},
-                                           counter{0},
-                                           elements{std::make_unique<T[]>(this->length)} {}
+template <typename T, typename Growth>
+MiniStack<T, Growth>::MiniStack(std::size_t len) : length{len > 0 ? len : kStackSize},
+                                                   minLength{this->length},
+                                                   counter{0},
+                                                   elements{std::make_unique<T[]>(this->length)} {}
 
-template <typename T>
-bool MiniStack<T>::empty() const noexcept
+template <typename T, typename Growth>
+bool MiniStack<T, Growth>::empty() const noexcept
 {
   return (counter == 0);
 }
 
-template <typename T>
-std::size_t MiniStack<T>::size() const noexcept
+template <typename T, typename Growth>
+std::size_t MiniStack<T, Growth>::size() const noexcept
 {
   return counter;
 }
 
-template <typename T>
-void MiniStack<T>::push(const T &t)
+template <typename T, typename Growth>
+std::size_t MiniStack<T, Growth>::capacity() const noexcept
+{
+  return length;
+}
+
+template <typename T, typename Growth>
+void MiniStack<T, Growth>::relocate(std::size_t len)
+{
+  std::unique_ptr<T[]> relocated = std::make_unique_for_overwrite<T[]>(len);
+  for (std::size_t i = 0; i < counter; ++i)
+  {
+    relocated[i] = std::move(elements[i]);
+  }
+
+  elements = std::move(relocated);
+  length = len;
+}
+
+template <typename T, typename Growth>
+void MiniStack<T, Growth>::push(const T &t)
 {
   if (counter >= length)
   {
-    throw std::runtime_error("Stack overflow in `push`");
+    if constexpr (std::is_same_v<Growth, FixedSize>)
+    {
+      throw std::runtime_error("Stack overflow in `push`");
+    }
+    else
+    {
+      const T value(t); // t may be an element of this stack
+      relocate(length > 0 ? length * 2 : kStackSize);
+      elements[counter++] = value;
+      return;
+    }
   }
 
   elements[counter++] = t;
 }
 
-template <typename T>
-T &MiniStack<T>::top() const
+template <typename T, typename Growth>
+T &MiniStack<T, Growth>::top() const
 {
   if (empty())
   {
@@ -80,8 +131,8 @@ T &MiniStack<T>::top() const
   return elements[counter - 1];
 }
 
-template <typename T>
-void MiniStack<T>::pop()
+template <typename T, typename Growth>
+void MiniStack<T, Growth>::pop()
 {
   if (empty())
   {
@@ -89,6 +140,65 @@ void MiniStack<T>::pop()
   }
 
   --counter;
+  shrinkIfSparse();
+}
+
+// GrowAndShrink: halves the buffer while it is at most a quarter full
+template <typename T, typename Growth>
+void MiniStack<T, Growth>::shrinkIfSparse()
+{
+  if constexpr (std::is_same_v<Growth, GrowAndShrink>)
+  {
+    std::size_t len = length;
+    while (counter * 4 <= len && len / 2 >= minLength)
+    {
+      len /= 2;
+    }
+
+    if (len != length)
+    {
+      relocate(len);
+    }
+  }
+}
+
+// Pushes values in order, so the last one ends up on top; values must not
+// refer into this stack
+template <typename T, typename Growth>
+void MiniStack<T, Growth>::push_bulk(std::span<const T> values)
+{
+  if (values.size() > length - counter)
+  {
+    if constexpr (std::is_same_v<Growth, FixedSize>)
+    {
+      throw std::runtime_error("Stack overflow in `push_bulk`");
+    }
+    else
+    {
+      std::size_t len = length > 0 ? length : kStackSize;
+      while (len - counter < values.size())
+      {
+        len *= 2;
+      }
+      relocate(len);
+    }
+  }
+
+  std::copy(values.begin(), values.end(), elements.get() + counter);
+  counter += values.size();
+}
+
+// Pops up to out.size() elements, top first, and returns how many
+template <typename T, typename Growth>
+std::size_t MiniStack<T, Growth>::pop_bulk(std::span<T> out)
+{
+  const std::size_t count = std::min(out.size(), counter);
+  T *top = elements.get() + counter;
+  std::move(std::make_reverse_iterator(top), std::make_reverse_iterator(top - count), out.begin());
+
+  counter -= count;
+  shrinkIfSparse();
+  return count;
 }
 
 #endif // MINISTACK_HPP_
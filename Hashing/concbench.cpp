@@ -0,0 +1,129 @@
+//--------------------------------------------------------------------
+//                        concbench.cpp
+//
+//  Multi-threaded throughput of HashTbl<..., Concurrent> against a
+//  Chained HashTbl behind one mutex, at read/write ratios of 100/0,
+//  95/5 and 50/50. Writes alternate insert and remove on random keys.
+//  Stand-alone driver, e.g.:
+//
+//    g++ -O2 -std=c++14 -pthread concbench.cpp -o concbench
+//--------------------------------------------------------------------
+
+#pragma warning( disable : 4290 )
+
+#include "hashtbl.h"
+#include "conctbl.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+struct Account
+{
+  const string& getKey() const { return username; }
+  string username,
+    password;
+};
+
+const int kKeys = 1 << 16;               // Key space; half is preloaded
+const int kOpsPerThread = 400000;
+
+vector<Account> accounts;
+
+// Gives the Chained table the same insert/remove/retrieve surface
+class LockedTable
+{
+public:
+  LockedTable(int size) : table(size) {}
+  void insert(const Account& item) { lock_guard<mutex> guard(lock); table.insert(item); }
+  bool remove(const string& key) { lock_guard<mutex> guard(lock); return table.remove(key); }
+  bool retrieve(const string& key, Account& item) { lock_guard<mutex> guard(lock); return table.retrieve(key, item); }
+
+private:
+  mutex lock;
+  HashTbl<Account, string, Chained, WyHash> table;
+};
+
+template < class Table >
+void worker(Table& table, unsigned seed, int writePercent, atomic<long>& found)
+{
+  Account item;
+  long hits = 0;
+  unsigned x = seed * 2654435761u + 1;   // xorshift32
+
+  for (int i = 0; i < kOpsPerThread; i++)
+  {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    const Account& account = accounts[x & (kKeys - 1)];
+
+    if (static_cast<int>((x >> 16) % 100) >= writePercent)
+      hits += table.retrieve(account.username, item);
+    else if (i & 1)
+      table.insert(account);
+    else
+      table.remove(account.username);
+  }
+  found += hits;
+}
+
+template < class Table >
+double run(int threads, int writePercent)
+{
+  Table table(kKeys);
+  atomic<long> found(0);
+  vector<thread> pool;
+
+  for (int i = 0; i < kKeys; i += 2)
+    table.insert(accounts[i]);
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int t = 0; t < threads; t++)
+    pool.push_back(thread(worker<Table>, ref(table), static_cast<unsigned>(t), writePercent, ref(found)));
+  for (size_t t = 0; t < pool.size(); t++)
+    pool[t].join();
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  return threads * static_cast<double>(kOpsPerThread) / seconds / 1e6;
+}
+
+int main()
+{
+  const int ratios[] = { 0, 5, 50 };     // Percent writes
+  int maxThreads = static_cast<int>(thread::hardware_concurrency());
+  vector<int> threadCounts;
+  for (int threads = 1; threads < maxThreads; threads *= 2)
+    threadCounts.push_back(threads);
+  threadCounts.push_back(maxThreads > 1 ? maxThreads : 1);
+
+  accounts.resize(kKeys);
+  for (int i = 0; i < kKeys; i++)
+  {
+    accounts[i].username = "user" + to_string(i);
+    accounts[i].password = "pw" + to_string(i);
+  }
+
+  cout << "Throughput in million operations per second, " << kOpsPerThread << " ops per thread\n\n";
+  cout << left << setw(10) << "read/write" << right << setw(9) << "threads"
+       << setw(12) << "concurrent" << setw(12) << "mutex" << "\n";
+  cout << fixed << setprecision(2);
+
+  for (int writePercent : ratios)
+  {
+    for (int threads : threadCounts)
+    {
+      double concurrent = run< HashTbl<Account, string, Concurrent, WyHash> >(threads, writePercent);
+      double locked = run<LockedTable>(threads, writePercent);
+
+      cout << left << setw(10) << (to_string(100 - writePercent) + "/" + to_string(writePercent))
+           << right << setw(9) << threads << setw(12) << concurrent << setw(12) << locked << "\n";
+    }
+  }
+}
@@ -0,0 +1,539 @@
+//--------------------------------------------------------------------
+//                        conctbl.h
+//
+//  Thread-safe backend for HashTbl, selected with
+//  HashTbl<T, KF, Concurrent> (or HashTbl<T, KF, Concurrent, Hasher>).
+//
+//  Readers never lock. Buckets are chains of immutable nodes linked
+//  through atomic pointers; a writer never edits a published node, it
+//  links in a fresh copy and retires the old one. Retired nodes are
+//  freed RCU-style: every reader announces itself in one of two
+//  counters picked by the current epoch, and the reclaimer flips the
+//  epoch and waits for the old counters to drain before deleting.
+//
+//  Writers serialise per stripe (a mutex chosen by the bucket index,
+//  so every writer to one chain holds the same lock), and inserts and
+//  removes on different stripes run in parallel. When
+//  the load passes max_load_factor() the writer that noticed takes all
+//  stripes and copies the table into one twice the size; readers keep
+//  using the old table until the new one is published.
+//--------------------------------------------------------------------
+
+#pragma once
+#ifndef CONCTBL_H_
+#define CONCTBL_H_
+
+#pragma warning( disable : 4290 )
+
+#include "hashtbl.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+template < class T, class KF, class Hasher >
+class HashTbl<T, KF, Concurrent, Hasher>
+{
+public:
+  HashTbl(int initTableSize);
+  ~HashTbl();
+
+  // Safe to call from any number of threads at once
+  void insert(const T& newDataItem) THROWS(bad_alloc);
+  bool remove(const KF& searchKey);
+  template < class K >
+  bool retrieve(const K& searchKey, T& dataItem) const;   // Lock-free
+  void clear();
+
+  bool isEmpty() const;
+  bool isFull() const;
+
+  float load_factor() const;
+  float max_load_factor() const;
+  void max_load_factor(float newMaxLoad);
+
+  void showStructure() const;
+
+private:
+  static const int kStripes = 64;          // Writer locks, power of two
+  static const int kReaderSlots = 64;      // Reader counters, power of two
+  static const size_t kRetireBatch = 128;  // Retired nodes per reclaim
+
+  struct Node
+  {
+    Node(const T& nodeData, Node* nextPtr) : dataItem(nodeData), next(nextPtr) {}
+    const T dataItem;
+    atomic<Node*> next;
+  };
+
+  struct Table
+  {
+    size_t size;
+    atomic<Node*>* heads;
+  };
+
+  struct alignas(64) Stripe
+  {
+    mutex lock;
+  };
+
+  struct alignas(64) ReaderCount
+  {
+    atomic<long> active[2];               // Indexed by epoch parity
+  };
+
+  // Marks a read-side critical section; nodes and tables seen inside
+  // one are not freed until it ends
+  class ReadGuard
+  {
+  public:
+    explicit ReadGuard(const HashTbl& owner);
+    ~ReadGuard();
+
+  private:
+    ReaderCount& slot;
+    unsigned parity;
+  };
+
+  static unsigned readerSlot();
+  static size_t bucketOf(uint64_t hashValue, size_t size);
+  static Table* newTable(size_t size) THROWS(bad_alloc);
+
+  Table* lockStripeFor(uint64_t hashValue, unique_lock<mutex>& guard);
+  void lockAll();
+  void unlockAll();
+  void grow();
+  void retire(Node* node);
+  void retire(Table* oldTable);
+  void reclaim();                         // Caller holds retireLock
+
+  mutable ReaderCount readers[kReaderSlots];
+  atomic<unsigned> epoch;
+  Stripe stripes[kStripes];
+
+  atomic<Table*> table;
+  atomic<long> itemCount;
+  atomic<float> maxLoad;
+
+  mutex retireLock;
+  vector<Node*> retiredNodes;
+  vector<Table*> retiredTables;
+};
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+HashTbl<T, KF, Concurrent, Hasher>::ReadGuard::ReadGuard(const HashTbl& owner)
+  : slot(owner.readers[readerSlot()])
+{
+  // Announce under the current epoch; if a reclaimer flipped it in
+  // between, back out and announce under the new one
+  for (;;)
+  {
+    unsigned e = owner.epoch.load();
+    parity = e & 1;
+    slot.active[parity].fetch_add(1);
+    if (owner.epoch.load() == e)
+      return;
+    slot.active[parity].fetch_sub(1);
+  }
+}
+
+template < class T, class KF, class Hasher >
+HashTbl<T, KF, Concurrent, Hasher>::ReadGuard::~ReadGuard()
+{
+  slot.active[parity].fetch_sub(1);
+}
+
+template < class T, class KF, class Hasher >
+unsigned HashTbl<T, KF, Concurrent, Hasher>::readerSlot()
+{
+  static atomic<unsigned> nextSlot(0);
+  thread_local unsigned slot = nextSlot++ & (kReaderSlots - 1);
+  return slot;
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+HashTbl<T, KF, Concurrent, Hasher>::HashTbl(int initTableSize)
+  : epoch(0), itemCount(0), maxLoad(1.0f)
+{
+  for (int i = 0; i < kReaderSlots; i++)
+  {
+    readers[i].active[0] = 0;
+    readers[i].active[1] = 0;
+  }
+  table = newTable(initTableSize > 0 ? initTableSize : 1);
+}
+
+template < class T, class KF, class Hasher >
+HashTbl<T, KF, Concurrent, Hasher>:: ~HashTbl()
+{
+  Table* current = table.load();
+
+  for (size_t i = 0; i < current->size; i++)
+  {
+    Node* p = current->heads[i].load();
+    while (p != 0)
+    {
+      Node* nextP = p->next.load();
+      delete p;
+      p = nextP;
+    }
+  }
+  delete[] current->heads;
+  delete current;
+
+  for (size_t i = 0; i < retiredNodes.size(); i++)
+    delete retiredNodes[i];
+  for (size_t i = 0; i < retiredTables.size(); i++)
+  {
+    delete[] retiredTables[i]->heads;
+    delete retiredTables[i];
+  }
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+size_t HashTbl<T, KF, Concurrent, Hasher>::bucketOf(uint64_t hashValue, size_t size)
+{
+  // fastrange on the high bits
+  return static_cast<size_t>(((hashValue >> 32) * static_cast<uint64_t>(size)) >> 32);
+}
+
+template < class T, class KF, class Hasher >
+typename HashTbl<T, KF, Concurrent, Hasher>::Table* HashTbl<T, KF, Concurrent, Hasher>::newTable(size_t size) THROWS(bad_alloc)
+{
+  Table* created = new Table;
+
+  try
+  {
+    created->heads = new atomic<Node*>[size];
+  }
+  catch (bad_alloc)
+  {
+    delete created;
+    throw;
+  }
+
+  created->size = size;
+  for (size_t i = 0; i < size; i++)
+    created->heads[i].store(0, memory_order_relaxed);
+  return created;
+}
+
+// Locks the stripe owning hashValue's bucket and returns the table the
+// bucket is in. grow() and clear() swap tables holding every stripe, so
+// the table is stable while any stripe is held; if it changed size
+// between picking the stripe and locking it, the bucket may belong to
+// another stripe now, so try again
+template < class T, class KF, class Hasher >
+typename HashTbl<T, KF, Concurrent, Hasher>::Table* HashTbl<T, KF, Concurrent, Hasher>::lockStripeFor(uint64_t hashValue, unique_lock<mutex>& guard)
+{
+  for (;;)
+  {
+    size_t size;
+    {
+      ReadGuard reading(*this);           // The table may be retired meanwhile
+      size = table.load()->size;
+    }
+
+    guard = unique_lock<mutex>(stripes[bucketOf(hashValue, size) & (kStripes - 1)].lock);
+    Table* current = table.load();
+    if (current->size == size)
+      return current;
+    guard.unlock();
+  }
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::lockAll()
+{
+  // Always in index order, and a writer holds at most one stripe
+  // otherwise, so this cannot deadlock
+  for (int i = 0; i < kStripes; i++)
+    stripes[i].lock.lock();
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::unlockAll()
+{
+  for (int i = kStripes - 1; i >= 0; i--)
+    stripes[i].lock.unlock();
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::retire(Node* node)
+{
+  lock_guard<mutex> guard(retireLock);
+
+  retiredNodes.push_back(node);
+  if (retiredNodes.size() >= kRetireBatch)
+    reclaim();
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::retire(Table* oldTable)
+{
+  lock_guard<mutex> guard(retireLock);
+
+  retiredTables.push_back(oldTable);
+  reclaim();
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::reclaim()
+{
+  // Everything in the retired lists is already unlinked, so only
+  // readers announced under the current epoch can still see it
+  unsigned e = epoch.load();
+  epoch.store(e + 1);
+
+  for (int i = 0; i < kReaderSlots; i++)
+  {
+    while (readers[i].active[e & 1].load() != 0)
+      this_thread::yield();
+  }
+
+  for (size_t i = 0; i < retiredNodes.size(); i++)
+    delete retiredNodes[i];
+  for (size_t i = 0; i < retiredTables.size(); i++)
+  {
+    delete[] retiredTables[i]->heads;
+    delete retiredTables[i];
+  }
+  retiredNodes.clear();
+  retiredTables.clear();
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::insert(const T& newDataItem) THROWS(bad_alloc)
+{
+  uint64_t h = Hasher()(newDataItem.getKey());
+  Node* replaced = 0;
+  size_t size;
+
+  {
+    unique_lock<mutex> guard;
+    Table* current = lockStripeFor(h, guard);
+    atomic<Node*>* link = &current->heads[bucketOf(h, current->size)];
+
+    for (Node* p = link->load(); p != 0; link = &p->next, p = p->next.load())
+    {
+      if (p->dataItem.getKey() == newDataItem.getKey())
+      {
+        link->store(new Node(newDataItem, p->next.load()));
+        replaced = p;
+        break;
+      }
+    }
+
+    if (replaced == 0)
+    {
+      atomic<Node*>& head = current->heads[bucketOf(h, current->size)];
+      head.store(new Node(newDataItem, head.load()));
+      itemCount++;
+    }
+    size = current->size;
+  }
+
+  if (replaced != 0)
+    retire(replaced);
+  else if (itemCount.load() > maxLoad.load() * size)
+    grow();
+}
+
+template < class T, class KF, class Hasher >
+bool HashTbl<T, KF, Concurrent, Hasher>::remove(const KF& searchKey)
+{
+  uint64_t h = Hasher()(searchKey);
+  Node* removed = 0;
+
+  {
+    unique_lock<mutex> guard;
+    Table* current = lockStripeFor(h, guard);
+    atomic<Node*>* link = &current->heads[bucketOf(h, current->size)];
+
+    for (Node* p = link->load(); p != 0; link = &p->next, p = p->next.load())
+    {
+      if (p->dataItem.getKey() == searchKey)
+      {
+        link->store(p->next.load());
+        removed = p;
+        itemCount--;
+        break;
+      }
+    }
+  }
+
+  if (removed == 0)
+    return false;
+
+  retire(removed);
+  return true;
+}
+
+template < class T, class KF, class Hasher >
+template < class K >
+bool HashTbl<T, KF, Concurrent, Hasher>::retrieve(const K& searchKey, T& dataItem) const
+{
+  ReadGuard guard(*this);
+  Table* current = table.load();
+
+  for (Node* p = current->heads[bucketOf(Hasher()(searchKey), current->size)].load(); p != 0; p = p->next.load())
+  {
+    if (p->dataItem.getKey() == searchKey)
+    {
+      dataItem = p->dataItem;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::grow()
+{
+  lockAll();
+
+  Table* current = table.load();
+  if (itemCount.load() <= maxLoad.load() * current->size)
+  {
+    unlockAll();                          // Another writer grew it first
+    return;
+  }
+
+  Table* bigger;
+  try
+  {
+    bigger = newTable(current->size * 2);
+  }
+  catch (bad_alloc)
+  {
+    unlockAll();                          // Keep serving from the old table
+    return;
+  }
+
+  // Readers may be walking the old chains, so copy rather than relink
+  for (size_t i = 0; i < current->size; i++)
+  {
+    for (Node* p = current->heads[i].load(); p != 0; p = p->next.load())
+    {
+      atomic<Node*>& head = bigger->heads[bucketOf(Hasher()(p->dataItem.getKey()), bigger->size)];
+      head.store(new Node(p->dataItem, head.load()), memory_order_relaxed);
+    }
+  }
+  table.store(bigger);
+
+  unlockAll();
+
+  lock_guard<mutex> guard(retireLock);
+  for (size_t i = 0; i < current->size; i++)
+  {
+    for (Node* p = current->heads[i].load(); p != 0; p = p->next.load())
+      retiredNodes.push_back(p);
+  }
+  retiredTables.push_back(current);
+  reclaim();
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::clear()
+{
+  lockAll();
+
+  Table* current = table.load();
+  Table* empty;
+  try
+  {
+    empty = newTable(current->size);
+  }
+  catch (bad_alloc)
+  {
+    unlockAll();
+    throw;
+  }
+  table.store(empty);
+  itemCount = 0;
+
+  unlockAll();
+
+  lock_guard<mutex> guard(retireLock);
+  for (size_t i = 0; i < current->size; i++)
+  {
+    for (Node* p = current->heads[i].load(); p != 0; p = p->next.load())
+      retiredNodes.push_back(p);
+  }
+  retiredTables.push_back(current);
+  reclaim();
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+bool HashTbl<T, KF, Concurrent, Hasher>::isEmpty() const
+{
+  return (itemCount.load() == 0);
+}
+
+template < class T, class KF, class Hasher >
+bool HashTbl<T, KF, Concurrent, Hasher>::isFull() const
+{
+  // Grows on demand; a failed growth leaves the table overloaded but
+  // working
+  return false;
+}
+
+template < class T, class KF, class Hasher >
+float HashTbl<T, KF, Concurrent, Hasher>::load_factor() const
+{
+  ReadGuard guard(*this);                 // A grow() may retire the table meanwhile
+  return static_cast<float>(itemCount.load()) / table.load()->size;
+}
+
+template < class T, class KF, class Hasher >
+float HashTbl<T, KF, Concurrent, Hasher>::max_load_factor() const
+{
+  return maxLoad.load();
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::max_load_factor(float newMaxLoad)
+{
+  if (newMaxLoad > 0.0f)
+    maxLoad = newMaxLoad;
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, Concurrent, Hasher>::showStructure() const
+{
+  ReadGuard guard(*this);
+  Table* current = table.load();
+
+  cout << "The Hash Table has the following entries" << endl;
+  for (size_t i = 0; i < current->size; i++)
+  {
+    cout << i << ": ";
+    Node* p = current->heads[i].load();
+    if (p == 0)
+      cout << "_";
+    for (; p != 0; p = p->next.load())
+      cout << p->dataItem.getKey() << " ";
+    cout << endl << endl;
+  }
+}
+
+#endif //CONCTBL_H_
@@ -0,0 +1,121 @@
+//--------------------------------------------------------------------
+//                        conctest.cpp
+//
+//  Multi-threaded correctness check for HashTbl<..., Concurrent>.
+//  Each thread inserts its own keys, replaces some of them and removes
+//  others while the rest run; afterwards every surviving key must be
+//  found with its last password and every removed key must be gone.
+//  Run once on a small table that never grows (long chains shared by
+//  many writers) and once on one that grows all the way through, with
+//  another thread reading load_factor() while it does.
+//  Stand-alone driver, e.g.:
+//
+//    g++ -O2 -std=c++14 -pthread conctest.cpp -o conctest
+//--------------------------------------------------------------------
+
+#pragma warning( disable : 4290 )
+
+#include "hashtbl.h"
+#include "conctbl.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+struct Account
+{
+  const string& getKey() const { return username; }
+  string username,
+    password;
+};
+
+typedef HashTbl<Account, string, Concurrent, WyHash> Table;
+
+const int kThreads = 8;
+const int kKeysPerThread = 3000;
+
+string keyOf(int thread, int i)
+{
+  return "user" + to_string(thread) + "_" + to_string(i);
+}
+
+// Every third key is removed again, every other key is replaced
+void worker(Table& table, int t)
+{
+  Account item;
+  for (int i = 0; i < kKeysPerThread; i++)
+  {
+    item.username = keyOf(t, i);
+    item.password = "pw";
+    table.insert(item);
+  }
+  for (int i = 0; i < kKeysPerThread; i++)
+  {
+    if (i % 3 == 0)
+      table.remove(keyOf(t, i));
+    else if (i % 2 == 0)
+    {
+      item.username = keyOf(t, i);
+      item.password = "new";
+      table.insert(item);
+    }
+  }
+}
+
+bool check(const char* name, int initSize, float maxLoad)
+{
+  Table table(initSize);
+  table.max_load_factor(maxLoad);
+
+  atomic<bool> done(false);
+  float highestLoad = 0;
+  thread watcher([&]() {
+    while (!done.load())
+      highestLoad = max(highestLoad, table.load_factor());
+  });
+
+  vector<thread> pool;
+  for (int t = 0; t < kThreads; t++)
+    pool.push_back(thread(worker, ref(table), t));
+  for (size_t t = 0; t < pool.size(); t++)
+    pool[t].join();
+  done = true;
+  watcher.join();
+
+  int found = 0, expected = 0, wrong = 0;
+  Account item;
+  for (int t = 0; t < kThreads; t++)
+  {
+    for (int i = 0; i < kKeysPerThread; i++)
+    {
+      bool present = table.retrieve(keyOf(t, i), item);
+      if (i % 3 == 0)
+      {
+        wrong += present;
+        continue;
+      }
+      expected++;
+      if (!present)
+        continue;
+      found++;
+      wrong += item.password != (i % 2 == 0 ? "new" : "pw");
+    }
+  }
+
+  bool passed = found == expected && wrong == 0;
+  cout << name << ": found " << found << " of " << expected << ", "
+       << wrong << " wrong, peak load " << highestLoad << " -- "
+       << (passed ? "pass" : "FAIL") << "\n";
+  return passed;
+}
+
+int main()
+{
+  bool passed = check("no growth, 64 buckets", 64, 1e9f);
+  passed = check("growing from 64 buckets", 64, 1.0f) && passed;
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,384 @@
+//--------------------------------------------------------------------
+//                        credindex.h
+//
+//  Prebuilt, memory-mapped credential index.
+//
+//  CredentialIndexWriter lays username/password pairs out as a flat
+//  open-addressed hash table and writes it to disk once (see
+//  mkcredidx.cpp). CredentialIndex maps that file read-only and looks
+//  keys up in place, so opening it costs the same for ten users or ten
+//  million: no parsing, no allocation, pages fault in on first touch.
+//
+//  File layout (native little-endian, all offsets from file start, so
+//  the mapping can land at any address):
+//
+//    Header                     magic, slot count (power of two),
+//                               item count, slot array offset, size,
+//                               size and mtime of the source file
+//    Slot[slotCount]            WyHash of the username, offset of the
+//                               username bytes, username and password
+//                               lengths; offset 0 marks an empty slot
+//    string bytes               username immediately followed by its
+//                               password, for every item
+//
+//  Lookups probe linearly from the home slot, comparing the stored
+//  64-bit hash before touching the strings.
+//
+//  The index is a snapshot of its source file, so readers should check
+//  matchesSource() before trusting it; an index built from an older or
+//  different password.txt fails that check.
+//--------------------------------------------------------------------
+
+#pragma once
+#ifndef CREDINDEX_H_
+#define CREDINDEX_H_
+
+#include "hashfunc.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+struct CredentialIndexHeader
+{
+  char magic[8];            // "CREDIDX2"
+  uint64_t slotCount;
+  uint64_t itemCount;
+  uint64_t slotsOffset;
+  uint64_t fileSize;
+  uint64_t sourceSize;      // Of the text file the index was built from
+  uint64_t sourceTime;      // Its last write time, 0 if unknown
+};
+
+// Size and last write time of path, in whatever units the platform
+// stats in; only ever compared with another call on the same machine
+inline bool credentialSourceStamp(const char* path, uint64_t& size, uint64_t& time)
+{
+#ifdef _WIN32
+  WIN32_FILE_ATTRIBUTE_DATA info;
+  if (!GetFileAttributesExA(path, GetFileExInfoStandard, &info))
+    return false;
+  size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+  time = (static_cast<uint64_t>(info.ftLastWriteTime.dwHighDateTime) << 32) | info.ftLastWriteTime.dwLowDateTime;
+#else
+  struct stat info;
+  if (stat(path, &info) != 0)
+    return false;
+  size = static_cast<uint64_t>(info.st_size);
+  time = static_cast<uint64_t>(info.st_mtime);
+#endif
+  return true;
+}
+
+struct CredentialIndexSlot
+{
+  uint64_t hash;
+  uint64_t keyOffset;       // 0 if the slot is empty
+  uint32_t keyLength;
+  uint32_t valueLength;
+};
+
+//--------------------------------------------------------------------
+//
+//  CredentialIndexWriter
+//
+//--------------------------------------------------------------------
+
+class CredentialIndexWriter
+{
+public:
+  CredentialIndexWriter();
+
+  void add(const string& username, const string& password);   // Later adds win
+  bool stampSource(const char* sourcePath);   // Call before reading it
+  bool write(const char* path) const;
+
+private:
+  vector<string> usernames,
+    passwords;
+  uint64_t sourceSize,
+    sourceTime;
+};
+
+inline CredentialIndexWriter::CredentialIndexWriter() : sourceSize(0), sourceTime(0)
+{}
+
+inline void CredentialIndexWriter::add(const string& username, const string& password)
+{
+  usernames.push_back(username);
+  passwords.push_back(password);
+}
+
+inline bool CredentialIndexWriter::stampSource(const char* sourcePath)
+{
+  return credentialSourceStamp(sourcePath, sourceSize, sourceTime);
+}
+
+inline bool CredentialIndexWriter::write(const char* path) const
+{
+  // Keep the load at or below one half so misses stop early
+  uint64_t slotCount = 16;
+  while (slotCount < 2 * usernames.size())
+    slotCount *= 2;
+
+  vector<CredentialIndexSlot> slots(static_cast<size_t>(slotCount));
+  vector<char> strings;
+  uint64_t slotsOffset = sizeof(CredentialIndexHeader);
+  uint64_t stringsOffset = slotsOffset + slotCount * sizeof(CredentialIndexSlot);
+  uint64_t itemCount = 0;
+
+  for (size_t i = 0; i < usernames.size(); i++)
+  {
+    const string& key = usernames[i];
+    uint64_t h = WyHash::hash(key.data(), key.size());
+    size_t index = static_cast<size_t>(h >> 32) & static_cast<size_t>(slotCount - 1);
+
+    while (slots[index].keyOffset != 0 &&
+           !(slots[index].hash == h && slots[index].keyLength == key.size() &&
+             memcmp(&strings[static_cast<size_t>(slots[index].keyOffset - stringsOffset)], key.data(), key.size()) == 0))
+      index = (index + 1) & static_cast<size_t>(slotCount - 1);
+
+    if (slots[index].keyOffset == 0)
+      itemCount++;
+
+    slots[index].hash = h;
+    slots[index].keyOffset = stringsOffset + strings.size();
+    slots[index].keyLength = static_cast<uint32_t>(key.size());
+    slots[index].valueLength = static_cast<uint32_t>(passwords[i].size());
+    strings.insert(strings.end(), key.begin(), key.end());
+    strings.insert(strings.end(), passwords[i].begin(), passwords[i].end());
+  }
+
+  CredentialIndexHeader header;
+  memcpy(header.magic, "CREDIDX2", 8);
+  header.slotCount = slotCount;
+  header.itemCount = itemCount;
+  header.slotsOffset = slotsOffset;
+  header.fileSize = stringsOffset + strings.size();
+  header.sourceSize = sourceSize;
+  header.sourceTime = sourceTime;
+
+  ofstream out(path, ios::binary | ios::trunc);
+  if (!out)
+    return false;
+
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(&slots[0]), static_cast<streamsize>(slots.size() * sizeof(CredentialIndexSlot)));
+  if (!strings.empty())
+    out.write(&strings[0], static_cast<streamsize>(strings.size()));
+  return static_cast<bool>(out);
+}
+
+//--------------------------------------------------------------------
+//
+//  CredentialIndex
+//
+//--------------------------------------------------------------------
+
+class CredentialIndex
+{
+public:
+  CredentialIndex();
+  ~CredentialIndex();
+
+  bool open(const char* path);   // False if missing or not a valid index
+  void close();
+
+  bool isOpen() const;
+  size_t size() const;
+
+  // False unless sourcePath still has the size and last write time it
+  // had when the index was built from it
+  bool matchesSource(const char* sourcePath) const;
+
+  // Password of username as a pointer into the mapping (not
+  // terminated), or 0 if absent. K is anything with data()/size().
+  template < class K >
+  const char* find(const K& username, size_t& passwordLength) const;
+
+  bool retrieve(const string& username, string& password) const;
+
+private:
+  CredentialIndex(const CredentialIndex&);              // Owns the mapping
+  CredentialIndex& operator=(const CredentialIndex&);
+
+  const char* base;
+  size_t mappedSize;
+  const CredentialIndexHeader* header;
+  const CredentialIndexSlot* slots;
+#ifdef _WIN32
+  HANDLE file,
+    mapping;
+#endif
+};
+
+inline CredentialIndex::CredentialIndex() : base(0), mappedSize(0), header(0), slots(0)
+#ifdef _WIN32
+  , file(INVALID_HANDLE_VALUE), mapping(0)
+#endif
+{}
+
+inline CredentialIndex::~CredentialIndex()
+{
+  close();
+}
+
+inline bool CredentialIndex::open(const char* path)
+{
+  close();
+
+#ifdef _WIN32
+  file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER length;
+  if (!GetFileSizeEx(file, &length) || length.QuadPart < static_cast<LONGLONG>(sizeof(CredentialIndexHeader)))
+  {
+    close();
+    return false;
+  }
+  mappedSize = static_cast<size_t>(length.QuadPart);
+
+  mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+  if (mapping != 0)
+    base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(CredentialIndexHeader)))
+  {
+    ::close(fd);
+    return false;
+  }
+  mappedSize = static_cast<size_t>(info.st_size);
+
+  void* view = mmap(0, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);                   // The mapping keeps the file alive
+  if (view != MAP_FAILED)
+    base = static_cast<const char*>(view);
+#endif
+
+  if (base == 0)
+  {
+    close();
+    return false;
+  }
+
+  // Validate once here so lookups only need the per-slot bound check
+  header = reinterpret_cast<const CredentialIndexHeader*>(base);
+  if (memcmp(header->magic, "CREDIDX2", 8) != 0 ||
+      header->fileSize != mappedSize ||
+      header->slotCount == 0 || (header->slotCount & (header->slotCount - 1)) != 0 ||
+      header->slotsOffset < sizeof(CredentialIndexHeader) ||
+      header->slotsOffset > mappedSize ||
+      header->slotCount > (mappedSize - header->slotsOffset) / sizeof(CredentialIndexSlot))
+  {
+    close();
+    return false;
+  }
+
+  slots = reinterpret_cast<const CredentialIndexSlot*>(base + header->slotsOffset);
+  return true;
+}
+
+inline void CredentialIndex::close()
+{
+#ifdef _WIN32
+  if (base != 0)
+    UnmapViewOfFile(base);
+  if (mapping != 0)
+    CloseHandle(mapping);
+  if (file != INVALID_HANDLE_VALUE)
+    CloseHandle(file);
+  mapping = 0;
+  file = INVALID_HANDLE_VALUE;
+#else
+  if (base != 0)
+    munmap(const_cast<char*>(base), mappedSize);
+#endif
+  base = 0;
+  mappedSize = 0;
+  header = 0;
+  slots = 0;
+}
+
+inline bool CredentialIndex::isOpen() const
+{
+  return (base != 0);
+}
+
+inline size_t CredentialIndex::size() const
+{
+  return header != 0 ? static_cast<size_t>(header->itemCount) : 0;
+}
+
+inline bool CredentialIndex::matchesSource(const char* sourcePath) const
+{
+  uint64_t size, time;
+  return header != 0 && header->sourceTime != 0 &&
+         credentialSourceStamp(sourcePath, size, time) &&
+         size == header->sourceSize && time == header->sourceTime;
+}
+
+template < class K >
+const char* CredentialIndex::find(const K& username, size_t& passwordLength) const
+{
+  if (base == 0)
+    return 0;
+
+  uint64_t h = WyHash::hash(username.data(), username.size());
+  uint64_t mask = header->slotCount - 1;
+
+  // At most slotCount probes even if a corrupt file has no empty slot
+  for (uint64_t i = (h >> 32) & mask, n = 0; n < header->slotCount; i = (i + 1) & mask, n++)
+  {
+    const CredentialIndexSlot& slot = slots[i];
+    if (slot.keyOffset == 0)
+      return 0;
+
+    if (slot.hash == h && slot.keyLength == username.size() &&
+        slot.keyOffset <= mappedSize && static_cast<uint64_t>(slot.keyLength) + slot.valueLength <= mappedSize - slot.keyOffset &&
+        memcmp(base + slot.keyOffset, username.data(), slot.keyLength) == 0)
+    {
+      passwordLength = slot.valueLength;
+      return base + slot.keyOffset + slot.keyLength;
+    }
+  }
+
+  return 0;
+}
+
+inline bool CredentialIndex::retrieve(const string& username, string& password) const
+{
+  size_t length;
+  const char* found = find(username, length);
+
+  if (found == 0)
+    return false;
+
+  password.assign(found, length);
+  return true;
+}
+
+#endif // CREDINDEX_H_
@@ -0,0 +1,112 @@
+//--------------------------------------------------------------------
+//                        findtest.cpp
+//
+//  Copy-free lookups through HashTbl::find (and the Concurrent
+//  backend's retrieve) on every backend. Keys are string_views cut
+//  out of one line of text, as a parser would hand them over, and
+//  plain const char*; neither builds a string. Needs C++17 for
+//  string_view. Stand-alone driver, e.g.:
+//
+//    cl /O2 /EHsc /std:c++17 findtest.cpp
+//    g++ -O2 -std=c++17 -pthread findtest.cpp -o findtest
+//--------------------------------------------------------------------
+
+#pragma warning( disable : 4290 )
+
+#include "hashtbl.h"
+#include "swisstbl.h"
+#include "conctbl.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+struct Account
+{
+  const string& getKey() const { return username; }
+  string username,
+    password;
+};
+
+const char* const kLine = "alice bob carol dave erin frank grace heidi";
+
+// Every name in kLine, in order, without copying any of them
+vector<string_view> namesIn(string_view line)
+{
+  vector<string_view> names;
+  while (!line.empty())
+  {
+    size_t end = line.find(' ');
+    names.push_back(line.substr(0, end));
+    line = (end == string_view::npos) ? string_view() : line.substr(end + 1);
+  }
+  return names;
+}
+
+template < class Table >
+void fill(Table& table, const vector<string_view>& names)
+{
+  Account item;
+  for (size_t i = 0; i < names.size(); i += 2)   // Every other name
+  {
+    item.username = string(names[i]);
+    item.password = "pw" + to_string(i);
+    table.insert(item);
+  }
+}
+
+template < class Backend >
+bool check(const char* name)
+{
+  HashTbl<Account, string, Backend, WyHash> table(4);
+  vector<string_view> names = namesIn(kLine);
+  fill(table, names);
+
+  int wrong = 0;
+  for (size_t i = 0; i < names.size(); i++)
+  {
+    const Account* found = table.find(names[i]);
+    if (i % 2 == 0)
+      wrong += (found == 0 || found->password != "pw" + to_string(i));
+    else
+      wrong += (found != 0);
+  }
+  wrong += (table.find("alice") == 0) + (table.find("mallory") != 0);
+
+  cout << name << ": " << wrong << " wrong -- " << (wrong == 0 ? "pass" : "FAIL") << "\n";
+  return wrong == 0;
+}
+
+// The Concurrent backend hands out copies, not pointers that a
+// concurrent remove could free, but takes the same keys
+bool checkConcurrent()
+{
+  HashTbl<Account, string, Concurrent, WyHash> table(4);
+  vector<string_view> names = namesIn(kLine);
+  fill(table, names);
+
+  int wrong = 0;
+  Account item;
+  for (size_t i = 0; i < names.size(); i++)
+  {
+    bool found = table.retrieve(names[i], item);
+    if (i % 2 == 0)
+      wrong += (!found || item.password != "pw" + to_string(i));
+    else
+      wrong += found;
+  }
+  wrong += !table.retrieve("alice", item) + table.retrieve("mallory", item);
+
+  cout << "Concurrent: " << wrong << " wrong -- " << (wrong == 0 ? "pass" : "FAIL") << "\n";
+  return wrong == 0;
+}
+
+int main()
+{
+  bool passed = check<Chained>("Chained");
+  passed = check<SwissTable>("SwissTable") && passed;
+  passed = checkConcurrent() && passed;
+  return passed ? 0 : 1;
+}
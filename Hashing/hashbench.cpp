@@ -0,0 +1,113 @@
+//--------------------------------------------------------------------
+//                        hashbench.cpp
+//
+//  Compares the HashTbl storage backends (Chained vs. SwissTable)
+//  at increasing load factors. Stand-alone driver, not part of the
+//  Hashing project (login.cpp owns main there), e.g.:
+//
+//    cl /O2 /EHsc hashbench.cpp
+//    g++ -O2 -std=c++14 hashbench.cpp -o hashbench
+//--------------------------------------------------------------------
+
+#pragma warning( disable : 4290 )
+
+#include "hashtbl.h"
+#include "swisstbl.h"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Same shape as login.cpp's Password, with a usable hash
+struct Account
+{
+  const string& getKey() const { return username; }
+
+  // FNV-1a
+  int hash(const string str) const
+  {
+    unsigned int val = 2166136261u;
+
+    for (unsigned int i = 0; i < str.length(); i++)
+    {
+      val ^= static_cast<unsigned char>(str[i]);
+      val *= 16777619u;
+    }
+    return static_cast<int>(val & 0x7fffffff);
+  }
+  string username,
+    password;
+};
+
+struct BenchResult
+{
+  double insertNs;
+  double hitNs;
+  double missNs;
+};
+
+template < class Backend >
+BenchResult runBackend(int tableSize, const vector<Account>& present, const vector<string>& absent)
+{
+  typedef chrono::steady_clock Clock;
+  BenchResult result;
+  HashTbl<Account, string, Backend> table(tableSize);
+  table.max_load_factor(1.0f);   // measure the requested load, no growth
+  Account found;
+  size_t hits = 0;
+
+  Clock::time_point start = Clock::now();
+  for (size_t i = 0; i < present.size(); i++)
+    table.insert(present[i]);
+  result.insertNs = chrono::duration<double, nano>(Clock::now() - start).count() / present.size();
+
+  start = Clock::now();
+  for (size_t i = 0; i < present.size(); i++)
+    hits += table.retrieve(present[i].username, found);
+  result.hitNs = chrono::duration<double, nano>(Clock::now() - start).count() / present.size();
+
+  start = Clock::now();
+  for (size_t i = 0; i < absent.size(); i++)
+    hits += table.retrieve(absent[i], found);
+  result.missNs = chrono::duration<double, nano>(Clock::now() - start).count() / absent.size();
+
+  if (hits != present.size())
+    cout << "unexpected hit count " << hits << endl;
+
+  return result;
+}
+
+int main()
+{
+  const int kTableSize = 1 << 17;   // buckets (Chained) == slots (SwissTable)
+  const double loadFactors[] = { 0.5, 0.75, 0.85, 0.9, 0.95 };
+
+  cout << "HashTbl backends, " << kTableSize << " buckets/slots, ns per operation\n\n";
+  cout << left << setw(8) << "load" << setw(10) << "backend"
+       << right << setw(10) << "insert" << setw(10) << "hit" << setw(10) << "miss" << "\n";
+  cout << fixed << setprecision(1);
+
+  for (double lf : loadFactors)
+  {
+    size_t n = static_cast<size_t>(lf * kTableSize);
+    vector<Account> present(n);
+    vector<string> absent(n);
+    for (size_t i = 0; i < n; i++)
+    {
+      present[i].username = "user" + to_string(i);
+      present[i].password = "pw" + to_string(i);
+      absent[i] = "nobody" + to_string(i);
+    }
+
+    BenchResult chained = runBackend<Chained>(kTableSize, present, absent);
+    BenchResult swiss = runBackend<SwissTable>(kTableSize, present, absent);
+
+    cout << left << setw(8) << setprecision(2) << lf << setprecision(1) << setw(10) << "chained"
+         << right << setw(10) << chained.insertNs << setw(10) << chained.hitNs << setw(10) << chained.missNs << "\n";
+    cout << left << setw(8) << "" << setw(10) << "swiss"
+         << right << setw(10) << swiss.insertNs << setw(10) << swiss.hitNs << setw(10) << swiss.missNs << "\n";
+  }
+}
@@ -0,0 +1,92 @@
+//--------------------------------------------------------------------
+//                        hashdist.cpp
+//
+//  Bucket distribution report: loads usernames into HashTbl with the
+//  old character-sum hash and with WyHash and prints the chain and
+//  probe length histograms of each. Stand-alone driver, e.g.:
+//
+//    g++ -O2 -std=c++14 hashdist.cpp -o hashdist
+//    hashdist password.txt      (username/password pairs)
+//    hashdist                   (10000 generated "userN" names)
+//--------------------------------------------------------------------
+
+#pragma warning( disable : 4290 )
+
+#include "hashtbl.h"
+#include "swisstbl.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+struct Account
+{
+  const string& getKey() const { return username; }
+  string username,
+    password;
+};
+
+// What Password::hash in login.cpp used to do: sum the characters
+struct CharSumHash
+{
+  uint64_t operator()(const string& str) const
+  {
+    int val = 0;
+
+    for (unsigned int i = 0; i < str.length(); i++)
+      val += str[i];
+    return mixHash(static_cast<uint32_t>(val));
+  }
+};
+
+template < class Backend, class Hasher >
+void report(const char* title, const vector<Account>& accounts)
+{
+  HashTbl<Account, string, Backend, Hasher> table(static_cast<int>(accounts.size()));
+
+  for (size_t i = 0; i < accounts.size(); i++)
+    table.insert(accounts[i]);
+
+  cout << "--- " << title << " ---" << endl;
+  table.showDistribution();
+  cout << endl;
+}
+
+int main(int argc, char* argv[])
+{
+  vector<Account> accounts;
+  Account account;
+
+  if (argc > 1)
+  {
+    ifstream passFile(argv[1]);
+    if (!passFile)
+    {
+      cout << "Unable to open '" << argv[1] << "'!" << endl;
+      return 1;
+    }
+    while (passFile >> account.username >> account.password)
+      accounts.push_back(account);
+  }
+  else
+  {
+    for (int i = 0; i < 10000; i++)
+    {
+      account.username = "user" + to_string(i);
+      accounts.push_back(account);
+    }
+  }
+
+  if (accounts.empty())
+  {
+    cout << "No usernames to report on" << endl;
+    return 1;
+  }
+
+  report<Chained, CharSumHash>("Chained, character sum (before)", accounts);
+  report<Chained, WyHash>("Chained, WyHash (after)", accounts);
+  report<SwissTable, CharSumHash>("SwissTable, character sum (before)", accounts);
+  report<SwissTable, WyHash>("SwissTable, WyHash (after)", accounts);
+}
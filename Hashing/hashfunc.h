@@ -0,0 +1,274 @@
+//--------------------------------------------------------------------
+//                        hashfunc.h
+//
+//  Hasher policies for HashTbl (its fourth template parameter).
+//
+//  A hasher is a stateless functor returning 64 well-mixed bits for a
+//  key; HashTbl reduces them to a bucket/slot itself. The Chained
+//  backend uses the high 32 bits (fastrange: (h >> 32) * size >> 32),
+//  SwissTable uses the low 7 bits as H2 and the rest for the home slot.
+//
+//    ItemHash<T>  T::hash(key), run through mixHash (the default)
+//    WyHash       wyhash for any key with data()/size(); keys of
+//                 kLongKey bytes or more are consumed in 32-byte
+//                 stripes, four lanes at a time (SSE2 when available)
+//    Fnv1aHash    FNV-1a, byte at a time; simple and portable
+//--------------------------------------------------------------------
+
+#pragma once
+#ifndef HASHFUNC_H_
+#define HASHFUNC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HASHFUNC_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+//--------------------------------------------------------------------
+
+// MurmurHash3 fmix64: spreads a small or clustered value over 64 bits
+inline uint64_t mixHash(uint64_t h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+template < class T >
+struct ItemHash
+{
+  template < class K >
+  uint64_t operator()(const K& key) const
+  {
+    return mixHash(static_cast<uint32_t>(T().hash(key)));
+  }
+};
+
+//--------------------------------------------------------------------
+
+struct WyHash
+{
+  static const size_t kLongKey = 256;   // Keys this long take the striped path
+
+  template < class K >
+  uint64_t operator()(const K& key) const
+  {
+    return hash(key.data(), key.size());
+  }
+
+  uint64_t operator()(const char* key) const
+  {
+    return hash(key, strlen(key));
+  }
+
+  static uint64_t hash(const void* key, size_t len, uint64_t seed = 0);
+
+private:
+  static const uint64_t* secret();
+  static uint64_t read8(const uint8_t* p);
+  static uint64_t read4(const uint8_t* p);
+  static uint64_t mum(uint64_t a, uint64_t b, uint64_t& hi);
+  static uint64_t mix(uint64_t a, uint64_t b);
+  static uint64_t shortHash(const uint8_t* p, size_t len, uint64_t seed);
+  static uint64_t stripes(const uint8_t* p, size_t count, uint64_t seed);
+};
+
+// Kept in a function so the header stays includable from several
+// translation units
+inline const uint64_t* WyHash::secret()
+{
+  static const uint64_t kSecret[4] = {
+    0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL
+  };
+  return kSecret;
+}
+
+inline uint64_t WyHash::read8(const uint8_t* p)
+{
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+inline uint64_t WyHash::read4(const uint8_t* p)
+{
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+inline uint64_t WyHash::mum(uint64_t a, uint64_t b, uint64_t& hi)
+{
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  hi = static_cast<uint64_t>(r >> 64);
+  return static_cast<uint64_t>(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  return _umul128(a, b, &hi);
+#else
+  uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  return lo;
+#endif
+}
+
+inline uint64_t WyHash::mix(uint64_t a, uint64_t b)
+{
+  uint64_t hi;
+  uint64_t lo = mum(a, b, hi);
+  return lo ^ hi;
+}
+
+inline uint64_t WyHash::shortHash(const uint8_t* p, size_t len, uint64_t seed)
+{
+  const uint64_t* s = secret();
+  uint64_t a, b;
+
+  seed ^= mix(seed ^ s[0], s[1]);
+  if (len <= 16)
+  {
+    if (len >= 4)
+    {
+      a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+      b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+    }
+    else if (len > 0)
+    {
+      a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+      b = 0;
+    }
+    else
+      a = b = 0;
+  }
+  else
+  {
+    size_t i = len;
+    if (i > 48)
+    {
+      uint64_t see1 = seed, see2 = seed;
+      do
+      {
+        seed = mix(read8(p) ^ s[1], read8(p + 8) ^ seed);
+        see1 = mix(read8(p + 16) ^ s[2], read8(p + 24) ^ see1);
+        see2 = mix(read8(p + 32) ^ s[3], read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16)
+    {
+      seed = mix(read8(p) ^ s[1], read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+
+  uint64_t hi;
+  uint64_t lo = mum(a ^ s[1], b ^ seed, hi);
+  return mix(lo ^ s[0] ^ len, hi ^ s[1]);
+}
+
+inline uint64_t WyHash::stripes(const uint8_t* p, size_t count, uint64_t seed)
+{
+  // xxHash3-style accumulation: each 64-bit lane adds its input word
+  // plus (word ^ secret).lo32 * (word ^ secret).hi32. The SSE2 and
+  // scalar paths compute exactly the same values.
+  const uint64_t* s = secret();
+  uint64_t acc[4] = { s[0] ^ seed, s[1], s[2], s[3] ^ seed };
+
+#ifdef HASHFUNC_SSE2
+  __m128i acc01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc));
+  __m128i acc23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + 2));
+  const __m128i key01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+  const __m128i key23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 2));
+
+  for (size_t n = 0; n < count; n++, p += 32)
+  {
+    __m128i data01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i data23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    __m128i mixed01 = _mm_xor_si128(data01, key01);
+    __m128i mixed23 = _mm_xor_si128(data23, key23);
+    acc01 = _mm_add_epi64(acc01, _mm_add_epi64(data01, _mm_mul_epu32(mixed01, _mm_srli_epi64(mixed01, 32))));
+    acc23 = _mm_add_epi64(acc23, _mm_add_epi64(data23, _mm_mul_epu32(mixed23, _mm_srli_epi64(mixed23, 32))));
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(acc), acc01);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + 2), acc23);
+#else
+  for (size_t n = 0; n < count; n++, p += 32)
+  {
+    for (int lane = 0; lane < 4; lane++)
+    {
+      uint64_t data = read8(p + 8 * lane);
+      uint64_t mixed = data ^ s[lane];
+      acc[lane] += data + (mixed & 0xffffffffULL) * (mixed >> 32);
+    }
+  }
+#endif
+
+  return mix(acc[0] ^ s[1], acc[1] ^ s[0]) ^ mix(acc[2] ^ s[3], acc[3] ^ s[2]);
+}
+
+inline uint64_t WyHash::hash(const void* key, size_t len, uint64_t seed)
+{
+  const uint8_t* p = static_cast<const uint8_t*>(key);
+
+  if (len < kLongKey)
+    return shortHash(p, len, seed);
+
+  // Whole stripes in parallel, then the tail (always >= 16 bytes so
+  // shortHash never reads before the key) folds in the stripe result
+  size_t count = (len - 16) / 32;
+  uint64_t folded = stripes(p, count, seed);
+  return shortHash(p + count * 32, len - count * 32, folded ^ len);
+}
+
+//--------------------------------------------------------------------
+
+struct Fnv1aHash
+{
+  template < class K >
+  uint64_t operator()(const K& key) const
+  {
+    return hash(key.data(), key.size());
+  }
+
+  uint64_t operator()(const char* key) const
+  {
+    return hash(key, strlen(key));
+  }
+
+  static uint64_t hash(const void* key, size_t len)
+  {
+    const uint8_t* p = static_cast<const uint8_t*>(key);
+    uint64_t h = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < len; i++)
+    {
+      h ^= p[i];
+      h *= 1099511628211ULL;
+    }
+    return mixHash(h);
+  }
+};
+
+#endif // HASHFUNC_H_
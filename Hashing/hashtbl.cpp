@@ -23,7 +23,7 @@ HashTbl<T, KF>:: ~HashTbl()
 }
 
 template < class T, class KF >
-void HashTbl<T, KF>::insert(const T& newDataItem) throw (bad_alloc)
+void HashTbl<T, KF>::insert(const T& newDataItem) THROWS(bad_alloc)
 {
   int index = 0;
   index = newDataItem.hash(newDataItem.getKey()) % tableSize;
@@ -9,153 +9,426 @@
 #pragma warning( disable : 4290 )
 
 #include "listlnk.h"
+#include "hashfunc.h"
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <exception>
 using namespace std;
 
-template < class T, class KF >
+// Storage policies for HashTbl. Chained keeps an array of List<T>
+// buckets (below); SwissTable keeps a flat open-addressed slot array
+// (see swisstbl.h); Concurrent is a thread-safe chained table with
+// lock-free readers (see conctbl.h). The Hasher policy maps a key to
+// 64 bits; see hashfunc.h.
+struct Chained {};
+struct SwissTable {};
+struct Concurrent {};
+
+template < class T, class KF, class Backend = Chained, class Hasher = ItemHash<T> >
 class HashTbl
 {
 public:
-  HashTbl(int initTableSize);
+  // Bucket nodes come from one NodePool shared by every bucket;
+  // maxItems > 0 caps it, and isFull() reports when the cap is hit
+  HashTbl(int initTableSize, int maxItems = 0);
   ~HashTbl();
 
-  void insert(const T& newDataItem) throw (bad_alloc);
-  bool remove(KF searchKey);
-  bool retrieve(KF searchKey, T& dataItem);
+  void insert(const T& newDataItem) THROWS(bad_alloc);
+  bool remove(const KF& searchKey);
+  bool retrieve(const KF& searchKey, T& dataItem);
   void clear();
 
+  // Lookup without copying: searchKey may be any type the Hasher
+  // accepts and T::getKey() compares equal to (e.g. string_view from
+  // C++17 callers, see findtest.cpp, or const char* for string keys).
+  // Returns the stored item, or 0 if absent; the pointer is valid
+  // until the next insert/remove/clear.
+  template < class K >
+  const T* find(const K& searchKey);
+
   bool isEmpty() const;
   bool isFull() const;
 
+  // Inserts [first, last) after sizing the table once for countHint
+  // more items (taken from the range itself for forward iterators)
+  template < class InputIt >
+  void bulk_insert(InputIt first, InputIt last, int countHint = 0) THROWS(bad_alloc);
+
+  // Growth: once an insert would push size / tableSize past
+  // max_load_factor() the table doubles, and the old buckets are
+  // moved across a few at a time by the following operations
+  void reserve(int count) THROWS(bad_alloc);   // Room for count items, rehashes now
+  float load_factor() const;
+  float max_load_factor() const;
+  void max_load_factor(float newMaxLoad);
+
   void showStructure() const;
+  void showDistribution() const;       // Chain length histogram
+
+  // Read-only forward iteration over every item, in no particular
+  // order, e.g. for (const T& item : table). Does not move any list
+  // cursor, so concurrent readers may iterate a table nobody is
+  // modifying. Any insert, remove, find or clear invalidates it.
+  class const_iterator
+  {
+  public:
+    typedef forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    const_iterator() : table(0), bucket(0) {}
+
+    reference operator*() const { return *item; }
+    pointer operator->() const { return &*item; }
+    const_iterator& operator++() { ++item; skipEmpty(); return *this; }
+    const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+
+    bool operator==(const const_iterator& other) const { return bucket == other.bucket && item == other.item; }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+  private:
+    const_iterator(const HashTbl* owner, int startBucket);
+    void skipEmpty();                  // On to the next non-empty bucket
+
+    const HashTbl* table;
+    int bucket;
+    typename List<T>::const_iterator item;
+
+    friend class HashTbl;
+  };
+
+  const_iterator begin() const;
+  const_iterator end() const;
 
 private:
+  static const int kMigrateStep = 4;   // Old buckets moved per operation
+
+  template < class InputIt >
+  static int countOf(InputIt first, InputIt last, input_iterator_tag);
+  template < class InputIt >
+  static int countOf(InputIt first, InputIt last, forward_iterator_tag);
+
+  static int bucketOf(uint64_t hashValue, int size);
+  template < class K >
+  List<T>& bucketFor(const K& key);    // Migrates the key's old bucket first
+  List<T>* newTable(int size) THROWS(bad_alloc);   // Buckets using nodes
+  void startRehash(int newTableSize) THROWS(bad_alloc);
+  void migrate(int bucketCount);
+  void migrateBucket(int index);
+  int bucketCount() const;             // Current buckets, then unmoved old ones
+  const List<T>& bucketAt(int index) const;
+
+  NodePool<T> nodes;   // Declared first: buckets must go before it
   int tableSize;
   List<T>* dataTable;
+  int itemCount;
+  float maxLoad;
+
+  int oldTableSize;    // Non-zero while a rehash is in progress
+  List<T>* oldTable;
+  int migrated;        // Old buckets below this index have been moved
 };
 
-template < class T, class KF >
-HashTbl<T, KF>::HashTbl(int initTableSize) : tableSize(initTableSize)
+template < class T, class KF, class Backend, class Hasher >
+HashTbl<T, KF, Backend, Hasher>::HashTbl(int initTableSize, int maxItems)
+  : nodes(maxItems), tableSize(initTableSize > 0 ? initTableSize : 1), itemCount(0), maxLoad(1.0f),
+    oldTableSize(0), oldTable(0), migrated(0)
 {
-  dataTable = new List<T>[tableSize];
+  dataTable = newTable(tableSize);
 }
 
-template < class T, class KF >
-HashTbl<T, KF>:: ~HashTbl()
+template < class T, class KF, class Backend, class Hasher >
+HashTbl<T, KF, Backend, Hasher>:: ~HashTbl()
 {
   delete[] dataTable;
+  delete[] oldTable;
 }
 
-template < class T, class KF >
-void HashTbl<T, KF>::insert(const T& newDataItem) throw (bad_alloc)
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Backend, class Hasher >
+int HashTbl<T, KF, Backend, Hasher>::bucketOf(uint64_t hashValue, int size)
 {
-  int index = 0;
-  index = newDataItem.hash(newDataItem.getKey()) % tableSize;
+  // apply two hash functions:
+  // convert the key to 64 bits (Hasher)
+  // and scale the high 32 bits into [0, size) (fastrange, no division)
+  return static_cast<int>(((hashValue >> 32) * static_cast<uint64_t>(size)) >> 32);
+}
+
+template < class T, class KF, class Backend, class Hasher >
+template < class K >
+List<T>& HashTbl<T, KF, Backend, Hasher>::bucketFor(const K& key)
+{
+  uint64_t h = Hasher()(key);
+
+  if (oldTable != 0)
+    migrateBucket(bucketOf(h, oldTableSize));
+
+  return dataTable[bucketOf(h, tableSize)];
+}
+
+template < class T, class KF, class Backend, class Hasher >
+List<T>* HashTbl<T, KF, Backend, Hasher>::newTable(int size) THROWS(bad_alloc)
+{
+  List<T>* table = new List<T>[size];
+
+  for (int i = 0; i < size; i++)
+    table[i].usePool(&nodes);
+  return table;
+}
+
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::startRehash(int newTableSize) THROWS(bad_alloc)
+{
+  List<T>* table = newTable(newTableSize);
+
+  oldTable = dataTable;
+  oldTableSize = tableSize;
+  migrated = 0;
+  dataTable = table;
+  tableSize = newTableSize;
+}
 
-  if (dataTable[index].isEmpty())
-    dataTable[index].insert(newDataItem);
-  else
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::migrate(int bucketCount)
+{
+  if (oldTable == 0)
+    return;
+
+  for (; bucketCount > 0 && migrated < oldTableSize; bucketCount--)
+    migrateBucket(migrated++);
+
+  if (migrated == oldTableSize)
   {
-    dataTable[index].gotoBeginning();
-    do
-    {
-      if (dataTable[index].getCursor().getKey() == newDataItem.getKey())
-      {
-        dataTable[index].replace(newDataItem);
-        return;
-      }
-    } while (dataTable[index].gotoNext());
-
-    dataTable[index].insert(newDataItem);
+    delete[] oldTable;
+    oldTable = 0;
+    oldTableSize = 0;
   }
 }
 
-template < class T, class KF >
-bool HashTbl<T, KF>::remove(KF searchKey)
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::migrateBucket(int index)
 {
-  T temp{};
-  int index = 0;
-  index = temp.hash(searchKey) % tableSize;
+  List<T>& bucket = oldTable[index];
 
-  if (dataTable[index].isEmpty())
-    return false;
+  // Relink the nodes rather than copy them, so a pool at its
+  // maxItems cap never needs room for both copies
+  while (!bucket.isEmpty())
+    bucket.transferFirst(dataTable[bucketOf(Hasher()(bucket.begin()->getKey()), tableSize)]);
+}
+
+template < class T, class KF, class Backend, class Hasher >
+int HashTbl<T, KF, Backend, Hasher>::bucketCount() const
+{
+  return tableSize + (oldTable != 0 ? oldTableSize - migrated : 0);
+}
+
+template < class T, class KF, class Backend, class Hasher >
+const List<T>& HashTbl<T, KF, Backend, Hasher>::bucketAt(int index) const
+{
+  return (index < tableSize ? dataTable[index] : oldTable[migrated + index - tableSize]);
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Backend, class Hasher >
+HashTbl<T, KF, Backend, Hasher>::const_iterator::const_iterator(const HashTbl* owner, int startBucket)
+  : table(owner), bucket(startBucket)
+{
+  if (bucket < table->bucketCount())
+  {
+    item = table->bucketAt(bucket).begin();
+    skipEmpty();
+  }
+}
+
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::const_iterator::skipEmpty()
+{
+  while (item == typename List<T>::const_iterator() && ++bucket < table->bucketCount())
+    item = table->bucketAt(bucket).begin();
+}
+
+template < class T, class KF, class Backend, class Hasher >
+typename HashTbl<T, KF, Backend, Hasher>::const_iterator HashTbl<T, KF, Backend, Hasher>::begin() const
+{
+  return const_iterator(this, 0);
+}
+
+template < class T, class KF, class Backend, class Hasher >
+typename HashTbl<T, KF, Backend, Hasher>::const_iterator HashTbl<T, KF, Backend, Hasher>::end() const
+{
+  return const_iterator(this, bucketCount());
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::insert(const T& newDataItem) THROWS(bad_alloc)
+{
+  if (oldTable == 0 && itemCount + 1 > maxLoad * tableSize)
+    startRehash(tableSize * 2);
+  migrate(kMigrateStep);
+
+  List<T>& bucket = bucketFor(newDataItem.getKey());
 
-  dataTable[index].gotoBeginning();
-  do
+  for (typename List<T>::iterator it = bucket.begin(); it != bucket.end(); ++it)
   {
-    if (dataTable[index].getCursor().getKey() == searchKey)
+    if (it->getKey() == newDataItem.getKey())
     {
-      dataTable[index].remove();
-      return true;
+      *it = newDataItem;
+      return;
     }
-  } while (dataTable[index].gotoNext());
+  }
 
-  return false;
+  bucket.insert(newDataItem);
+  itemCount++;
 }
 
-template < class T, class KF >
-bool HashTbl<T, KF>::retrieve(KF searchKey, T& dataItem)
+template < class T, class KF, class Backend, class Hasher >
+template < class InputIt >
+void HashTbl<T, KF, Backend, Hasher>::bulk_insert(InputIt first, InputIt last, int countHint) THROWS(bad_alloc)
 {
-  // apply two hash functions:
-  // convert string (searchkey) to integer
-  // and use the remainder method (% tableSize) to get the index
+  if (countHint <= 0)
+    countHint = countOf(first, last, typename iterator_traits<InputIt>::iterator_category());
+  if (countHint > 0)
+    reserve(itemCount + countHint);
 
-  int index = 0;
-  index = dataItem.hash(searchKey) % tableSize;
+  for (; first != last; ++first)
+    insert(*first);
+}
 
-  if (dataTable[index].isEmpty())
-    return false;
+template < class T, class KF, class Backend, class Hasher >
+template < class InputIt >
+int HashTbl<T, KF, Backend, Hasher>::countOf(InputIt, InputIt, input_iterator_tag)
+{
+  return 0;                            // Single pass, cannot look ahead
+}
 
-  dataTable[index].gotoBeginning();
-  do
+template < class T, class KF, class Backend, class Hasher >
+template < class InputIt >
+int HashTbl<T, KF, Backend, Hasher>::countOf(InputIt first, InputIt last, forward_iterator_tag)
+{
+  return static_cast<int>(distance(first, last));
+}
+
+template < class T, class KF, class Backend, class Hasher >
+bool HashTbl<T, KF, Backend, Hasher>::remove(const KF& searchKey)
+{
+  migrate(kMigrateStep);
+
+  List<T>& bucket = bucketFor(searchKey);
+
+  for (typename List<T>::iterator it = bucket.begin(); it != bucket.end(); ++it)
   {
-    if (dataTable[index].getCursor().getKey() == searchKey)
+    if (it->getKey() == searchKey)
     {
-      dataItem = dataTable[index].getCursor();
+      bucket.erase(it);
+      itemCount--;
       return true;
     }
-  } while (dataTable[index].gotoNext());
+  }
 
   return false;
 }
 
-template < class T, class KF >
-void HashTbl<T, KF>::clear()
+template < class T, class KF, class Backend, class Hasher >
+bool HashTbl<T, KF, Backend, Hasher>::retrieve(const KF& searchKey, T& dataItem)
 {
-  for (int i = 0; i < tableSize; i++)
+  const T* item = find(searchKey);
+
+  if (item == 0)
+    return false;
+
+  dataItem = *item;
+  return true;
+}
+
+template < class T, class KF, class Backend, class Hasher >
+template < class K >
+const T* HashTbl<T, KF, Backend, Hasher>::find(const K& searchKey)
+{
+  migrate(kMigrateStep);
+
+  const List<T>& bucket = bucketFor(searchKey);
+
+  for (typename List<T>::const_iterator it = bucket.begin(); it != bucket.end(); ++it)
   {
-    dataTable[i].clear();
+    if (it->getKey() == searchKey)
+      return &*it;
   }
+
+  return 0;
 }
 
-template < class T, class KF >
-bool HashTbl<T, KF>::isEmpty() const
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::clear()
 {
   for (int i = 0; i < tableSize; i++)
   {
-    if (!dataTable[i].isEmpty())
-      return false;
+    dataTable[i].clear();
   }
 
-  return true;
+  delete[] oldTable;
+  oldTable = 0;
+  oldTableSize = 0;
+  itemCount = 0;
 }
 
-template < class T, class KF >
-bool HashTbl<T, KF>::isFull() const
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::reserve(int count) THROWS(bad_alloc)
 {
-  for (int i = 0; i < tableSize; i++)
+  int needed = static_cast<int>(count / maxLoad) + 1;
+
+  migrate(oldTableSize);
+  if (needed > tableSize)
   {
-    if (!dataTable[i].isFull())
-      return false;
+    startRehash(needed);
+    migrate(oldTableSize);
   }
+}
 
-  return true;
+template < class T, class KF, class Backend, class Hasher >
+float HashTbl<T, KF, Backend, Hasher>::load_factor() const
+{
+  return static_cast<float>(itemCount) / tableSize;
+}
+
+template < class T, class KF, class Backend, class Hasher >
+float HashTbl<T, KF, Backend, Hasher>::max_load_factor() const
+{
+  return maxLoad;
+}
+
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::max_load_factor(float newMaxLoad)
+{
+  if (newMaxLoad > 0.0f)
+    maxLoad = newMaxLoad;
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Backend, class Hasher >
+bool HashTbl<T, KF, Backend, Hasher>::isEmpty() const
+{
+  return (itemCount == 0);
+}
+
+template < class T, class KF, class Backend, class Hasher >
+bool HashTbl<T, KF, Backend, Hasher>::isFull() const
+{
+  return nodes.isFull();
 }
 
-template < class T, class KF >
-void HashTbl<T, KF>::showStructure() const
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::showStructure() const
 {
   cout << "The Hash Table has the following entries" << endl;
   for (int i = 0; i < tableSize; i++)
@@ -165,14 +438,50 @@ void HashTbl<T, KF>::showStructure() const
       cout << "_";
     else
     {
-      dataTable[i].gotoBeginning();
-      do
-      {
-        cout << dataTable[i].getCursor().getKey() << " ";
-      } while (dataTable[i].gotoNext());
+      for (typename List<T>::const_iterator it = dataTable[i].begin(); it != dataTable[i].end(); ++it)
+        cout << it->getKey() << " ";
     }
     cout << endl << endl;
   }
+
+  if (oldTable != 0)
+  {
+    cout << "Rehash in progress, entries not yet moved:" << endl;
+    for (int i = migrated; i < oldTableSize; i++)
+    {
+      for (typename List<T>::const_iterator it = oldTable[i].begin(); it != oldTable[i].end(); ++it)
+        cout << it->getKey() << " ";
+    }
+    cout << endl << endl;
+  }
+}
+
+template < class T, class KF, class Backend, class Hasher >
+void HashTbl<T, KF, Backend, Hasher>::showDistribution() const
+{
+  const int kLongest = 16;             // Longer chains share the last row
+  int histogram[kLongest + 1] = {};
+  int longest = 0;
+
+  for (int i = 0; i < tableSize; i++)
+  {
+    int length = static_cast<int>(distance(dataTable[i].begin(), dataTable[i].end()));
+    histogram[length < kLongest ? length : kLongest]++;
+    if (length > longest)
+      longest = length;
+  }
+
+  cout << "Chain lengths: " << itemCount << " items in " << tableSize
+       << " buckets, load " << load_factor() << ", longest " << longest << endl;
+  if (oldTable != 0)
+    cout << "(rehash in progress, unmoved entries not counted)" << endl;
+  for (int length = 0; length <= kLongest; length++)
+  {
+    if (histogram[length] == 0)
+      continue;
+    cout << (length < kLongest ? "  " : ">=") << length << ": " << histogram[length]
+         << " buckets (" << 100.0 * histogram[length] / tableSize << "%)" << endl;
+  }
 }
 
 #endif //HASHTBL_H_
@@ -34,7 +34,7 @@ List<T>:: ~List()
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::insert(const T& newDataItem) throw (bad_alloc)
+void List<T>::insert(const T& newDataItem) THROWS(bad_alloc)
 {
   if (head == 0)             // Empty list
   {
@@ -51,7 +51,7 @@ void List<T>::insert(const T& newDataItem) throw (bad_alloc)
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::remove() throw (logic_error)
+void List<T>::remove() THROWS(logic_error)
 {
   ListNode<T>* p,   // Pointer to removed node
     * q;   // Pointer to prior node
@@ -87,7 +87,7 @@ void List<T>::remove() throw (logic_error)
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::replace(const T& newDataItem) throw (logic_error)
+void List<T>::replace(const T& newDataItem) THROWS(logic_error)
 {
   if (head == 0)
     throw logic_error("list is empty");
@@ -145,7 +145,7 @@ bool List<T>::isFull() const
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::gotoBeginning() throw (logic_error)
+void List<T>::gotoBeginning() THROWS(logic_error)
 {
   if (head != 0)
     cursor = head;
@@ -156,7 +156,7 @@ void List<T>::gotoBeginning() throw (logic_error)
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::gotoEnd() throw (logic_error)
+void List<T>::gotoEnd() THROWS(logic_error)
 {
   if (head != 0)
     for (; cursor->next != 0; cursor = cursor->next)
@@ -212,7 +212,7 @@ bool List<T>::gotoPrior()
 //--------------------------------------------------------------------
 
 template < class T >
-T List<T>::getCursor() const throw (logic_error)
+T List<T>::getCursor() const THROWS(logic_error)
 {
   if (head == 0)
     throw logic_error("list is empty");
@@ -243,7 +243,7 @@ void List<T>::showStructure() const
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::moveToBeginning() throw (logic_error)
+void List<T>::moveToBeginning() THROWS(logic_error)
 
 // Removes the item marked by the cursor from a list and
 // reinserts it at the beginning of the list. Moves the cursor to the
@@ -268,7 +268,7 @@ void List<T>::moveToBeginning() throw (logic_error)
 
 template < class T >
 void List<T>::insertBefore(const T& newDataItem)
-throw (bad_alloc)
+THROWS(bad_alloc)
 
 // Inserts newDataItem before the cursor. If the list is empty, then
 // newDataItem is inserted as the first (and only) item in the list.
@@ -9,24 +9,131 @@
 
 #pragma warning( disable : 4290 )
 
+// Dynamic exception specification. C++17 dropped them, so there it
+// expands to nothing and the list stays usable from C++17 callers
+// (e.g. HashTbl::find with a string_view key).
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define THROWS(...)
+#else
+#define THROWS(...) throw (__VA_ARGS__)
+#endif
+
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <exception>
+#include <new>
 #include <stdexcept>
+#include <vector>
 using namespace std;
 
 template < class T >         // Forward declaration of the List class
 class List;
 
+template < class T, class Ref, class Ptr >
+class ListIterator;
+
 template < class T >
 class ListNode                // Facilitator class for the List class
 {
 private:
 
-  ListNode(const T& nodeData, ListNode* nextPtr);
+  ListNode(const T& nodeData, ListNode* priorPtr, ListNode* nextPtr);
   T dataItem;      // List data item
-  ListNode* next;   // Pointer to the next list node
+  ListNode* prior,  // Pointer to the previous list node, so removal
+    * next;         // and gotoPrior need not walk from head
+
+  friend class List<T>;
+  template < class U, class Ref, class Ptr >
+  friend class ListIterator;
+};
+
+//--------------------------------------------------------------------
+
+// Forward iterator over a List, independent of the list's cursor, so
+// any number of them can walk one list (including a const one) at
+// once. List<T>::iterator yields T&, List<T>::const_iterator const T&.
+// Removing the node an iterator is on invalidates that iterator.
+
+template < class T, class Ref, class Ptr >
+class ListIterator
+{
+public:
+
+  typedef forward_iterator_tag iterator_category;
+  typedef T value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Ptr pointer;
+  typedef Ref reference;
+
+  ListIterator() : node(0) {}
+  ListIterator(const ListIterator<T, T&, T*>& other) : node(other.node) {}   // iterator to const_iterator
+
+  reference operator*() const { return node->dataItem; }
+  pointer operator->() const { return &node->dataItem; }
+  ListIterator& operator++() { node = node->next; return *this; }
+  ListIterator operator++(int) { ListIterator old = *this; node = node->next; return old; }
+
+  bool operator==(const ListIterator& other) const { return node == other.node; }
+  bool operator!=(const ListIterator& other) const { return node != other.node; }
+
+private:
+
+  explicit ListIterator(ListNode<T>* p) : node(p) {}
+  ListNode<T>* node;
 
   friend class List<T>;
+  template < class U, class R, class P >
+  friend class ListIterator;
+};
+
+//--------------------------------------------------------------------
+
+// Slab allocator for ListNode<T>. Nodes are carved in order from
+// contiguous blocks (each as large as all earlier blocks together, up
+// to kMaxBlock nodes) and freed nodes go onto a LIFO free list for
+// reuse, so many Lists sharing one pool (e.g. the buckets of a
+// HashTbl) touch a few blocks rather than one heap allocation per
+// node. Blocks are only returned to the heap when the pool is
+// destroyed, so every List using it must be gone first.
+
+template < class T >
+class NodePool
+{
+public:
+
+  NodePool(int maxNodes = 0);   // 0 for no limit
+  ~NodePool();
+
+  void* allocate() THROWS(bad_alloc);
+  void release(void* node);
+
+  bool isFull() const;          // No free node and at maxNodes
+  int capacity() const;         // Nodes carved or ready to carve
+  int inUse() const;
+  int blockCount() const;       // Heap allocations made
+
+private:
+
+  static const int kFirstBlock = 32,
+    kMaxBlock = 4096;
+
+  union Slot
+  {
+    Slot* next;                 // While on the free list
+    alignas(ListNode<T>) unsigned char storage[sizeof(ListNode<T>)];
+  };
+
+  NodePool(const NodePool&);    // Owns the blocks
+  NodePool& operator=(const NodePool&);
+
+  vector<Slot*> blocks;
+  Slot* freeList;
+  Slot* fresh;                  // Uncarved part of the newest block
+  int freshLeft,
+    carved,
+    used,
+    maxNodes;
 };
 
 //--------------------------------------------------------------------
@@ -38,27 +145,49 @@ public:
 
   List(int ignored = 0);
   ~List();
-  void insert(const T& newData) throw (bad_alloc);        // Insert after cursor
-  void remove() throw (logic_error);                      // Remove data item
-  void replace(const T& newData)  throw (logic_error);    // Replace data item
+  void usePool(NodePool<T>* nodePool) THROWS(logic_error);  // Only while empty
+  void insert(const T& newData) THROWS(bad_alloc);        // Insert after cursor
+  void remove() THROWS(logic_error);                      // Remove data item
+  void replace(const T& newData)  THROWS(logic_error);    // Replace data item
   void clear();
 
   bool isEmpty() const;
   bool isFull() const;
 
   // List iteration operations
-  void gotoBeginning()   throw (logic_error);
-  void gotoEnd()  throw (logic_error);
+  void gotoBeginning()   THROWS(logic_error);
+  void gotoEnd()  THROWS(logic_error);
   bool gotoNext();
   bool gotoPrior();
-  T getCursor() const throw (logic_error);                   // Return item
+  const T& getCursor() const THROWS(logic_error);            // Return item
   void showStructure() const;
-  void moveToBeginning() throw (logic_error);                    // Move to beginning
-  void insertBefore(const T& newElement)  throw (bad_alloc);  // Insert before cursor
+  void moveToBeginning() THROWS(logic_error);                    // Move to beginning
+  void insertBefore(const T& newElement)  THROWS(bad_alloc);  // Insert before cursor
+
+  // Unlinks the first node and inserts it after target's cursor
+  // without copying or allocating. Both lists must use the same pool.
+  void transferFirst(List<T>& target) THROWS(logic_error);
+
+  // Cursor-free traversal, e.g. for (const T& item : list)
+  typedef ListIterator<T, T&, T*> iterator;
+  typedef ListIterator<T, const T&, const T*> const_iterator;
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  // Removes the item at position and returns the one after it. A
+  // cursor on that item moves as for remove().
+  iterator erase(iterator position) THROWS(logic_error);
 
 private:
+  ListNode<T>* newNode(const T& nodeData, ListNode<T>* priorPtr, ListNode<T>* nextPtr) THROWS(bad_alloc);
+  void deleteNode(ListNode<T>* p);
+
   ListNode<T>* head,     // Pointer to the beginning of the list
     * cursor;   // Cursor pointer
+  NodePool<T>* pool;     // 0 to use new/delete
 };
 
 //--------------------------------------------------------------------
@@ -77,17 +206,146 @@ private:
 using namespace std;
 
 template < class T >
-ListNode<T>::ListNode(const T& nodeDataItem, ListNode<T>* nextPtr) : dataItem(nodeDataItem), next(nextPtr)
+ListNode<T>::ListNode(const T& nodeDataItem, ListNode<T>* priorPtr, ListNode<T>* nextPtr)
+  : dataItem(nodeDataItem), prior(priorPtr), next(nextPtr)
 {}
 
 //--------------------------------------------------------------------
 
 template < class T >
-List<T>::List(int ignored) : head(0), cursor(0)
+NodePool<T>::NodePool(int maxNodes)
+  : freeList(0), fresh(0), freshLeft(0), carved(0), used(0), maxNodes(maxNodes > 0 ? maxNodes : 0)
+{}
+
+template < class T >
+NodePool<T>::~NodePool()
+{
+  for (size_t i = 0; i < blocks.size(); i++)
+    delete[] blocks[i];
+}
+
+template < class T >
+void* NodePool<T>::allocate() THROWS(bad_alloc)
+{
+  Slot* slot;
+
+  if (freeList != 0)           // Most recently freed first, likely cached
+  {
+    slot = freeList;
+    freeList = freeList->next;
+  }
+  else
+  {
+    if (freshLeft == 0)
+    {
+      int size = (carved < kFirstBlock ? kFirstBlock : carved < kMaxBlock ? carved : kMaxBlock);
+      if (maxNodes > 0 && size > maxNodes - carved)
+        size = maxNodes - carved;
+      if (size <= 0)
+        throw bad_alloc();
+
+      blocks.reserve(blocks.size() + 1);
+      fresh = new Slot[size];
+      blocks.push_back(fresh);
+      freshLeft = size;
+    }
+
+    slot = fresh++;
+    freshLeft--;
+    carved++;
+  }
+
+  used++;
+  return slot;
+}
+
+template < class T >
+void NodePool<T>::release(void* node)
+{
+  Slot* slot = static_cast<Slot*>(node);
+
+  slot->next = freeList;
+  freeList = slot;
+  used--;
+}
+
+template < class T >
+bool NodePool<T>::isFull() const
+{
+  return (freeList == 0 && freshLeft == 0 && maxNodes > 0 && carved >= maxNodes);
+}
+
+template < class T >
+int NodePool<T>::capacity() const
+{
+  return carved + freshLeft;
+}
+
+template < class T >
+int NodePool<T>::inUse() const
+{
+  return used;
+}
+
+template < class T >
+int NodePool<T>::blockCount() const
+{
+  return static_cast<int>(blocks.size());
+}
+
+//--------------------------------------------------------------------
+
+template < class T >
+List<T>::List(int ignored) : head(0), cursor(0), pool(0)
 {}
 
 //--------------------------------------------------------------------
 
+template < class T >
+void List<T>::usePool(NodePool<T>* nodePool) THROWS(logic_error)
+{
+  if (head != 0)
+    throw logic_error("list is not empty");
+
+  pool = nodePool;
+}
+
+//--------------------------------------------------------------------
+
+template < class T >
+ListNode<T>* List<T>::newNode(const T& nodeDataItem, ListNode<T>* priorPtr, ListNode<T>* nextPtr) THROWS(bad_alloc)
+{
+  if (pool == 0)
+    return new ListNode<T>(nodeDataItem, priorPtr, nextPtr);
+
+  void* storage = pool->allocate();
+  try
+  {
+    return new (storage) ListNode<T>(nodeDataItem, priorPtr, nextPtr);
+  }
+  catch (...)
+  {
+    pool->release(storage);
+    throw;
+  }
+}
+
+//--------------------------------------------------------------------
+
+template < class T >
+void List<T>::deleteNode(ListNode<T>* p)
+{
+  if (pool == 0)
+    delete p;
+  else
+  {
+    p->~ListNode<T>();
+    pool->release(p);
+  }
+}
+
+//--------------------------------------------------------------------
+
 template < class T >
 List<T>:: ~List()
 {
@@ -97,60 +355,39 @@ List<T>:: ~List()
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::insert(const T& newDataItem) throw (bad_alloc)
+void List<T>::insert(const T& newDataItem) THROWS(bad_alloc)
 {
   if (head == 0)             // Empty list
   {
-    head = new ListNode<T>(newDataItem, 0);
+    head = newNode(newDataItem, 0, 0);
     cursor = head;
   }
   else                         // After cursor
   {
-    cursor->next = new ListNode<T>(newDataItem, cursor->next);
-    cursor = cursor->next;
+    ListNode<T>* p = newNode(newDataItem, cursor, cursor->next);
+    if (cursor->next != 0)
+      cursor->next->prior = p;
+    cursor->next = p;
+    cursor = p;
   }
 }
 
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::remove() throw (logic_error)
+void List<T>::remove() THROWS(logic_error)
 {
-  ListNode<T>* p,   // Pointer to removed node
-    * q;   // Pointer to prior node
-
   // Requires that the list is not empty
   if (head == 0)
     throw logic_error("list is empty");
 
-  if (cursor == head)             // Remove first item
-  {
-    p = head;
-    head = head->next;
-    cursor = head;
-  }
-  else if (cursor->next != 0)     // Remove middle item
-  {
-    p = cursor->next;
-    cursor->dataItem = p->dataItem;
-    cursor->next = p->next;
-  }
-  else                              // Remove last item
-  {
-    p = cursor;
-    for (q = head; q->next != cursor; q = q->next)
-      ;
-    q->next = 0;
-    cursor = head;
-  }
-
-  delete p;
+  erase(iterator(cursor));
 }
 
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::replace(const T& newDataItem) throw (logic_error)
+void List<T>::replace(const T& newDataItem) THROWS(logic_error)
 {
   if (head == 0)
     throw logic_error("list is empty");
@@ -169,7 +406,7 @@ void List<T>::clear()
   while (p != 0)
   {
     nextP = p->next;
-    delete p;
+    deleteNode(p);
     p = nextP;
   }
 
@@ -189,12 +426,15 @@ bool List<T>::isEmpty() const
 template < class T >
 bool List<T>::isFull() const
 {
+  if (pool != 0)
+    return pool->isFull();
+
   T testDataItem{};
   ListNode<T>* p;
 
   try
   {
-    p = new ListNode<T>(testDataItem, 0);
+    p = new ListNode<T>(testDataItem, 0, 0);
   }
   catch (bad_alloc)
   {
@@ -208,7 +448,7 @@ bool List<T>::isFull() const
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::gotoBeginning() throw (logic_error)
+void List<T>::gotoBeginning() THROWS(logic_error)
 {
   if (head != 0)
     cursor = head;
@@ -219,7 +459,7 @@ void List<T>::gotoBeginning() throw (logic_error)
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::gotoEnd() throw (logic_error)
+void List<T>::gotoEnd() THROWS(logic_error)
 {
   if (head != 0)
     for (; cursor->next != 0; cursor = cursor->next)
@@ -256,14 +496,11 @@ bool List<T>::gotoPrior()
 // Otherwise, returns 0.
 
 {
-  ListNode<T>* p;   // Pointer to prior node
   int result;        // Result returned
 
   if (cursor != head)
   {
-    for (p = head; p->next != cursor; p = p->next)
-      ;
-    cursor = p;
+    cursor = cursor->prior;
     result = true;
   }
   else
@@ -275,7 +512,7 @@ bool List<T>::gotoPrior()
 //--------------------------------------------------------------------
 
 template < class T >
-T List<T>::getCursor() const throw (logic_error)
+const T& List<T>::getCursor() const THROWS(logic_error)
 {
   if (head == 0)
     throw logic_error("list is empty");
@@ -306,23 +543,24 @@ void List<T>::showStructure() const
 //--------------------------------------------------------------------
 
 template < class T >
-void List<T>::moveToBeginning() throw (logic_error)
+void List<T>::moveToBeginning() THROWS(logic_error)
 
 // Removes the item marked by the cursor from a list and
 // reinserts it at the beginning of the list. Moves the cursor to the
 // beginning of the list.
 {
-  ListNode<T>* p;   //  Pointer to prior node
   // Requires that the list is not empty
   if (head == 0)
     throw logic_error("list is empty");
 
   if (cursor != head)
   {
-    for (p = head; p->next != cursor; p = p->next)
-      ;
-    p->next = cursor->next;
+    cursor->prior->next = cursor->next;
+    if (cursor->next != 0)
+      cursor->next->prior = cursor->prior;
+    cursor->prior = 0;
     cursor->next = head;
+    head->prior = cursor;
     head = cursor;
   }
 }
@@ -331,7 +569,7 @@ void List<T>::moveToBeginning() throw (logic_error)
 
 template < class T >
 void List<T>::insertBefore(const T& newDataItem)
-throw (bad_alloc)
+THROWS(bad_alloc)
 
 // Inserts newDataItem before the cursor. If the list is empty, then
 // newDataItem is inserted as the first (and only) item in the list.
@@ -340,14 +578,107 @@ throw (bad_alloc)
 {
   if (head == 0)             // Empty list
   {
-    head = new ListNode<T>(newDataItem, 0);
+    head = newNode(newDataItem, 0, 0);
     cursor = head;
   }
   else                         // Before cursor
   {
-    cursor->next = new ListNode<T>(cursor->dataItem, cursor->next);
-    cursor->dataItem = newDataItem;
+    ListNode<T>* p = newNode(newDataItem, cursor->prior, cursor);
+    if (cursor->prior != 0)
+      cursor->prior->next = p;
+    else
+      head = p;
+    cursor->prior = p;
+    cursor = p;
+  }
+}
+
+//--------------------------------------------------------------------
+
+template < class T >
+void List<T>::transferFirst(List<T>& target) THROWS(logic_error)
+{
+  if (head == 0)
+    throw logic_error("list is empty");
+  if (target.pool != pool)
+    throw logic_error("lists use different pools");
+
+  ListNode<T>* p = head;
+  head = head->next;
+  if (head != 0)
+    head->prior = 0;
+  if (cursor == p)
+    cursor = head;
+
+  if (target.head == 0)
+  {
+    p->prior = 0;
+    p->next = 0;
+    target.head = p;
   }
+  else
+  {
+    p->prior = target.cursor;
+    p->next = target.cursor->next;
+    if (p->next != 0)
+      p->next->prior = p;
+    target.cursor->next = p;
+  }
+  target.cursor = p;
+}
+
+//--------------------------------------------------------------------
+
+template < class T >
+typename List<T>::iterator List<T>::begin()
+{
+  return iterator(head);
+}
+
+template < class T >
+typename List<T>::iterator List<T>::end()
+{
+  return iterator(0);
+}
+
+template < class T >
+typename List<T>::const_iterator List<T>::begin() const
+{
+  return const_iterator(head);
+}
+
+template < class T >
+typename List<T>::const_iterator List<T>::end() const
+{
+  return const_iterator(0);
+}
+
+//--------------------------------------------------------------------
+
+template < class T >
+typename List<T>::iterator List<T>::erase(iterator position) THROWS(logic_error)
+{
+  ListNode<T>* p = position.node;   // Pointer to removed node
+
+  if (p == 0)
+    throw logic_error("erase at end");
+
+  // Unlink in place; the cursor moves to the next item, or to the
+  // beginning if the last item was removed
+  if (p->prior != 0)
+    p->prior->next = p->next;
+  else
+    head = p->next;
+
+  if (p->next != 0)
+    p->next->prior = p->prior;
+
+  if (cursor == p)
+    cursor = (p->next != 0 ? p->next : head);
+
+  iterator following(p->next);
+  deleteNode(p);
+  return following;
 }
 
-#endif // LISTLNK_H_
\ No newline at end of file
+#endif // LISTLNK_H_
@@ -8,6 +8,8 @@
 #pragma warning( disable : 4290 )
 
 #include "hashtbl.h"
+#include "credindex.h"
+#include "pairread.h"
 
 #include <string>
 #include <iostream>
@@ -18,50 +20,58 @@ using namespace std;
 struct Password
 {
   void setKey(string newKey) { username = newKey; }
-  string getKey() const { return username; }
+  const string& getKey() const { return username; }
 
-  //this hash converts a string to an integer
-  int hash(const string str) const
-  {
-    int val = 0;
-
-    for (unsigned int i = 0; i < str.length(); i++)
-      val += str[i];
-    return val;
-  }
+  // hashed by WyHash (hashfunc.h), see the HashTbl below
   string username,
     password;
 };
 
 int main()
 {
-  HashTbl<Password, string> passwords(10);
+  HashTbl<Password, string, Chained, WyHash> passwords(10);
   Password tempPass;
   string name;      // user-supplied name
   string pass;      // user-supplied password
   //bool userFound;   // is user in table?
 
       //*********************************************************
-      // Step 1: Read in the password file
+      // Step 1: Map the prebuilt index (mkcredidx) if there is
+      // one built from the current password file, otherwise read
+      // in the password file
       //*********************************************************
-  ifstream passFile("password.txt");
+  CredentialIndex index;
+  bool mapped = index.open("password.idx");
 
-  if (!passFile)
+  if (mapped && !index.matchesSource("password.txt"))
   {
-    cout << "Unable to open 'password.txt'!" << endl;
-    return 1;
+    cout << "'password.idx' is out of date with 'password.txt', ignoring it" << endl;
+    index.close();
+    mapped = false;
   }
-  passFile >> tempPass.username;
-  while (!passFile.eof() && !passwords.isFull())
-  {
-    //**add line here to insert passwords into the HashTbl
 
-    passFile >> tempPass.password;
+  if (mapped)
+    cout << "Mapped 'password.idx' (" << index.size() << " users)" << endl;
+  else
+  {
+    PairReader passFile("password.txt");
+
+    if (!passFile.isOpen())
+    {
+      cout << "Unable to open 'password.txt'!" << endl;
+      return 1;
+    }
+
+    // Size the table once up front; insert() then never has to grow
+    // it or probe isFull() per line
+    passwords.reserve(passFile.estimatedPairs());
+    while (passFile.next(tempPass.username, tempPass.password))
+      passwords.insert(tempPass);
+
+    cout << "Printing the hash table:..." << endl;
+    passwords.showStructure();
   }
 
-  cout << "Printing the hash table:..." << endl;
-  //**add line here to show (print) the HashTbl
-
 
   //*********************************************************
   // Step 2: Prompt for a Login and Password and check if valid
@@ -69,15 +79,24 @@ int main()
   cout << "Login: ";
   while (cin >> name)  // to quit, type CTRL Z in Visual C++
   {
-    //**add line here to retrieve user from HashTbl
-
+    // Both lookups compare in place, nothing is copied out
+    const char* storedPass = 0;
+    size_t storedLength = 0;
+    if (mapped)
+      storedPass = index.find(name, storedLength);
+    else if (const Password* user = passwords.find(name))
+    {
+      storedPass = user->password.data();
+      storedLength = user->password.size();
+    }
 
     cout << "Password: ";
     cin >> pass;
 
-    //**add lines here to compare retrieved user password to
-    //**input password and print "Authentication failure"
-    //**or "Authentication successful"
+    if (storedPass != 0 && pass.compare(0, string::npos, storedPass, storedLength) == 0)
+      cout << "Authentication successful" << endl;
+    else
+      cout << "Authentication failure" << endl;
 
     cout << "Login: ";
   }
@@ -0,0 +1,55 @@
+//--------------------------------------------------------------------
+//                        mkcredidx.cpp
+//
+//  Offline builder for the memory-mapped credential index read by
+//  login.cpp (see credindex.h). Stand-alone driver, e.g.:
+//
+//    g++ -O2 -std=c++14 mkcredidx.cpp -o mkcredidx
+//    mkcredidx password.txt password.idx
+//--------------------------------------------------------------------
+
+#include "credindex.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+  const char* inPath = argc > 1 ? argv[1] : "password.txt";
+  const char* outPath = argc > 2 ? argv[2] : "password.idx";
+  CredentialIndexWriter writer;
+  string username,
+    password;
+  size_t count = 0;
+
+  // Stamp before reading, so an edit made while we read shows as stale
+  ifstream passFile(inPath);
+  if (!passFile || !writer.stampSource(inPath))
+  {
+    cout << "Unable to open '" << inPath << "'!" << endl;
+    return 1;
+  }
+
+  while (passFile >> username >> password)
+  {
+    writer.add(username, password);
+    count++;
+  }
+
+  if (!writer.write(outPath))
+  {
+    cout << "Unable to write '" << outPath << "'!" << endl;
+    return 1;
+  }
+
+  CredentialIndex index;
+  if (!index.open(outPath))
+  {
+    cout << "'" << outPath << "' did not verify" << endl;
+    return 1;
+  }
+
+  cout << "Indexed " << index.size() << " users (" << count << " lines) into '" << outPath << "'" << endl;
+}
@@ -0,0 +1,140 @@
+//--------------------------------------------------------------------
+//                        nodebench.cpp
+//
+//  Heap allocations and time for chained buckets with one new/delete
+//  per node (List<T> on its own, isFull() probed before each insert
+//  as login.cpp used to) against buckets sharing a NodePool. Counts
+//  come from the replaced global operator new below. Stand-alone
+//  driver, e.g.:
+//
+//    g++ -O2 -std=c++14 nodebench.cpp -o nodebench
+//--------------------------------------------------------------------
+
+#pragma warning( disable : 4290 )
+
+#include "hashtbl.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <string>
+#include <vector>
+using namespace std;
+
+static long allocations = 0;
+
+void* operator new(size_t size)
+{
+  allocations++;
+  if (void* p = malloc(size ? size : 1))
+    return p;
+  throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+  free(p);
+}
+
+struct Account
+{
+  const string& getKey() const { return username; }
+  string username,      // Short enough to stay in the string itself
+    password;
+};
+
+const int kItems = 200000;
+const int kBuckets = kItems;
+const int kRounds = 4;          // Remove and reinsert half, this many times
+
+vector<Account> accounts;
+
+struct Result
+{
+  long allocations;
+  double ms;
+};
+
+// Insert everything, then churn half the items, over plain buckets
+Result runBuckets(bool pooled)
+{
+  NodePool<Account> pool;
+  List<Account>* buckets = new List<Account>[kBuckets];
+  if (pooled)
+    for (int i = 0; i < kBuckets; i++)
+      buckets[i].usePool(&pool);
+
+  long before = allocations;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  for (int round = 0; round <= kRounds; round++)
+  {
+    for (int i = (round == 0 ? 0 : 1); i < kItems; i += (round == 0 ? 1 : 2))
+    {
+      List<Account>& bucket = buckets[WyHash()(accounts[i].username) % kBuckets];
+      if (!bucket.isFull())
+        bucket.insert(accounts[i]);
+    }
+    for (int i = 1; i < kItems; i += 2)
+    {
+      List<Account>& bucket = buckets[WyHash()(accounts[i].username) % kBuckets];
+      bucket.gotoBeginning();
+      while (bucket.getCursor().username != accounts[i].username)
+        bucket.gotoNext();
+      bucket.remove();
+    }
+  }
+
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+  Result result = { allocations - before, ms };
+
+  delete[] buckets;
+  return result;
+}
+
+// The same load through HashTbl, which now pools its bucket nodes
+Result runTable()
+{
+  long before = allocations;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  {
+    HashTbl<Account, string, Chained, WyHash> table(16);
+    for (int i = 0; i < kItems; i++)
+      if (!table.isFull())
+        table.insert(accounts[i]);
+  }
+
+  double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+  Result result = { allocations - before, ms };
+  return result;
+}
+
+int main()
+{
+  accounts.resize(kItems);
+  for (int i = 0; i < kItems; i++)
+  {
+    accounts[i].username = "u" + to_string(i);
+    accounts[i].password = "p" + to_string(i);
+  }
+
+  Result plain = runBuckets(false),
+    pooled = runBuckets(true),
+    table = runTable();
+
+  cout << kItems << " items in " << kBuckets << " buckets, " << kRounds
+       << " rounds removing and reinserting half\n\n";
+  cout << left << setw(26) << "" << right << setw(14) << "allocations" << setw(10) << "ms" << "\n";
+  cout << fixed << setprecision(1);
+  cout << left << setw(26) << "List, new/delete per node" << right << setw(14) << plain.allocations << setw(10) << plain.ms << "\n";
+  cout << left << setw(26) << "List, shared NodePool" << right << setw(14) << pooled.allocations << setw(10) << pooled.ms << "\n";
+  cout << left << setw(26) << "HashTbl load from 16" << right << setw(14) << table.allocations << setw(10) << table.ms << "\n";
+}
@@ -0,0 +1,121 @@
+//--------------------------------------------------------------------
+//                        pairread.h
+//
+//  Buffered reader for whitespace-separated pairs ("username password"
+//  per line in password.txt). The file is read in large chunks and
+//  tokens are scanned straight out of the buffer into the caller's
+//  strings, which are reused, so a reload costs one read per chunk
+//  rather than stream extraction per token.
+//--------------------------------------------------------------------
+
+#pragma once
+#ifndef PAIRREAD_H_
+#define PAIRREAD_H_
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+class PairReader
+{
+public:
+  PairReader(const char* path, size_t chunkSize = 1 << 20);
+
+  bool isOpen() const;
+  int estimatedPairs() const;          // From the first chunk's density
+
+  bool next(string& first, string& second);   // False once the file is used up
+
+private:
+  bool fill();                         // Next chunk into buffer, false at end
+  bool token(string& out);
+
+  ifstream file;
+  vector<char> buffer;
+  size_t pos,
+    end;
+  int estimate;
+};
+
+inline PairReader::PairReader(const char* path, size_t chunkSize)
+  : file(path, ios::binary), buffer(chunkSize > 0 ? chunkSize : 1), pos(0), end(0), estimate(0)
+{
+  if (!file)
+    return;
+
+  file.seekg(0, ios::end);
+  streamoff fileSize = file.tellg();
+  file.seekg(0, ios::beg);
+
+  if (!fill())
+    return;
+
+  // Count tokens in the first chunk and scale to the whole file
+  long tokens = 0;
+  bool inToken = false;
+  for (size_t i = 0; i < end; i++)
+  {
+    bool space = (buffer[i] == ' ' || buffer[i] == '\t' || buffer[i] == '\n' || buffer[i] == '\r');
+    if (!space && !inToken)
+      tokens++;
+    inToken = !space;
+  }
+  estimate = static_cast<int>(tokens / 2 * (static_cast<double>(fileSize) / end));
+}
+
+inline bool PairReader::isOpen() const
+{
+  return file.is_open();
+}
+
+inline int PairReader::estimatedPairs() const
+{
+  return estimate;
+}
+
+inline bool PairReader::fill()
+{
+  if (!file)
+    return false;
+
+  file.read(&buffer[0], static_cast<streamsize>(buffer.size()));
+  end = static_cast<size_t>(file.gcount());
+  pos = 0;
+  return end > 0;
+}
+
+inline bool PairReader::token(string& out)
+{
+  out.clear();
+
+  // Skip separators, refilling as needed
+  for (;;)
+  {
+    while (pos < end && (buffer[pos] == ' ' || buffer[pos] == '\t' || buffer[pos] == '\n' || buffer[pos] == '\r'))
+      pos++;
+    if (pos < end)
+      break;
+    if (!fill())
+      return false;
+  }
+
+  // Copy the token a run at a time; it may straddle two chunks
+  for (;;)
+  {
+    size_t start = pos;
+    while (pos < end && buffer[pos] != ' ' && buffer[pos] != '\t' && buffer[pos] != '\n' && buffer[pos] != '\r')
+      pos++;
+    out.append(&buffer[start], pos - start);
+    if (pos < end || !fill())
+      return true;
+  }
+}
+
+inline bool PairReader::next(string& first, string& second)
+{
+  return token(first) && token(second);
+}
+
+#endif // PAIRREAD_H_
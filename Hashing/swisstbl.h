@@ -0,0 +1,711 @@
+//--------------------------------------------------------------------
+//                        swisstbl.h
+//
+//  Open-addressing backend for HashTbl, selected with
+//  HashTbl<T, KF, SwissTable> (or HashTbl<T, KF, SwissTable, Hasher>).
+//
+//  Items live in one flat slot array. A parallel array of one-byte
+//  control words holds either kEmpty or the low 7 bits of the item's
+//  hash (H2, the remaining bits pick the home slot), so a probe compares 16 control bytes at once (SSE2 when
+//  available) and only touches a slot when its H2 matches.
+//
+//  Probing is linear from the home slot, one 16-byte group at a time,
+//  and stops at the first group containing an empty slot. Deletion
+//  shifts later members of the run back into the hole (Knuth's
+//  Algorithm R), so the table never needs tombstones.
+//
+//  Growth doubles the slot array. The old array is kept read-only and
+//  drained a few groups per operation; a drained (or superseded) old
+//  slot is marked kMoved so probe runs in the old array stay intact.
+//--------------------------------------------------------------------
+
+#pragma once
+#ifndef SWISSTBL_H_
+#define SWISSTBL_H_
+
+#pragma warning( disable : 4290 )
+
+#include "hashtbl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <exception>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISSTBL_SSE2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+//--------------------------------------------------------------------
+//
+//  SwissGroup: a window of 16 control bytes
+//
+//--------------------------------------------------------------------
+
+class SwissGroup
+{
+public:
+  static const int width = 16;
+  static const int8_t kEmpty = -128;     // 0b10000000, full slots are 0..127
+  static const int8_t kMoved = -2;       // Old-array slot already migrated
+
+  explicit SwissGroup(const int8_t* ctrl);
+
+  unsigned match(int8_t h2) const;       // Bit i set if byte i == h2
+  unsigned matchEmpty() const;           // Bit i set if byte i is empty
+
+  static int lowestBit(unsigned mask);   // Index of the lowest set bit
+
+private:
+#ifdef SWISSTBL_SSE2
+  __m128i bytes;
+#else
+  const int8_t* bytes;
+#endif
+};
+
+//--------------------------------------------------------------------
+
+#ifdef SWISSTBL_SSE2
+
+inline SwissGroup::SwissGroup(const int8_t* ctrl)
+  : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+{}
+
+inline unsigned SwissGroup::match(int8_t h2) const
+{
+  return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes)));
+}
+
+inline unsigned SwissGroup::matchEmpty() const
+{
+  return match(kEmpty);
+}
+
+#else
+
+inline SwissGroup::SwissGroup(const int8_t* ctrl) : bytes(ctrl)
+{}
+
+inline unsigned SwissGroup::match(int8_t h2) const
+{
+  unsigned mask = 0;
+  for (int i = 0; i < width; i++)
+    if (bytes[i] == h2)
+      mask |= 1u << i;
+  return mask;
+}
+
+inline unsigned SwissGroup::matchEmpty() const
+{
+  return match(kEmpty);
+}
+
+#endif
+
+inline int SwissGroup::lowestBit(unsigned mask)
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<int>(index);
+#elif defined(__GNUC__)
+  return __builtin_ctz(mask);
+#else
+  int index = 0;
+  while (!(mask & 1u))
+  {
+    mask >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+//--------------------------------------------------------------------
+//
+//  HashTbl<T, KF, SwissTable>
+//
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+class HashTbl<T, KF, SwissTable, Hasher>
+{
+public:
+  HashTbl(int initTableSize);
+  ~HashTbl();
+
+  void insert(const T& newDataItem) THROWS(bad_alloc);
+  bool remove(const KF& searchKey);
+  bool retrieve(const KF& searchKey, T& dataItem);
+  void clear();
+
+  // Copy-free lookup by any key the Hasher accepts and T::getKey()
+  // compares equal to; see HashTbl::find in hashtbl.h
+  template < class K >
+  const T* find(const K& searchKey);
+
+  bool isEmpty() const;
+  bool isFull() const;
+
+  template < class InputIt >
+  void bulk_insert(InputIt first, InputIt last, int countHint = 0) THROWS(bad_alloc);
+
+  void reserve(int count) THROWS(bad_alloc);   // Room for count items, rehashes now
+  float load_factor() const;
+  float max_load_factor() const;
+  void max_load_factor(float newMaxLoad);
+
+  void showStructure() const;
+  void showDistribution() const;       // Probe length histogram
+
+  // Read-only forward iteration over every item; see
+  // HashTbl::const_iterator in hashtbl.h
+  class const_iterator
+  {
+  public:
+    typedef forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    const_iterator() : table(0), index(0), item(0) {}
+
+    reference operator*() const { return *item; }
+    pointer operator->() const { return item; }
+    const_iterator& operator++() { ++index; skipEmpty(); return *this; }
+    const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+
+    bool operator==(const const_iterator& other) const { return index == other.index; }
+    bool operator!=(const const_iterator& other) const { return index != other.index; }
+
+  private:
+    const_iterator(const HashTbl* owner, size_t startIndex);
+    void skipEmpty();                  // On to the next full slot
+
+    const HashTbl* table;
+    size_t index;
+    const T* item;
+
+    friend class HashTbl;
+  };
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+private:
+  static const int kMigrateStep = 2;   // Old groups moved per operation
+
+  struct Slots
+  {
+    size_t capacity;   // Number of slots, a power of two >= SwissGroup::width
+    size_t mask;       // capacity - 1
+    int8_t* ctrl;      // capacity control bytes + (width - 1) mirrored bytes
+    T* items;
+  };
+
+  template < class InputIt >
+  static int countOf(InputIt first, InputIt last, input_iterator_tag);
+  template < class InputIt >
+  static int countOf(InputIt first, InputIt last, forward_iterator_tag);
+
+  template < class K >
+  static uint64_t hashOf(const K& key);
+  static void allocate(Slots& slots, size_t capacity) THROWS(bad_alloc);
+  static void release(Slots& slots);
+  static void setCtrl(Slots& slots, size_t index, int8_t value);
+  template < class K >
+  static long probe(const Slots& slots, const K& searchKey, uint64_t h);
+  static void place(Slots& slots, const T& newDataItem, uint64_t h);
+  static void erase(Slots& slots, size_t index);
+
+  void startRehash(size_t newCapacity) THROWS(bad_alloc);
+  void migrate(int groupCount);
+  size_t slotCount() const;            // Current slots, then unmoved old ones
+  const T* slotAt(size_t index) const; // 0 if that slot holds no item
+
+  Slots table;
+  size_t count;      // Items in table and not yet migrated from oldTable
+  float maxLoad;
+
+  Slots oldTable;    // oldTable.ctrl is non-null while a rehash is in progress
+  size_t migrated;   // Old slots below this index have been moved
+};
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+HashTbl<T, KF, SwissTable, Hasher>::HashTbl(int initTableSize) : count(0), maxLoad(0.875f), migrated(0)
+{
+  size_t capacity = SwissGroup::width;
+  while (capacity < static_cast<size_t>(initTableSize))
+    capacity *= 2;
+
+  allocate(table, capacity);
+  oldTable.ctrl = 0;
+  oldTable.items = 0;
+}
+
+template < class T, class KF, class Hasher >
+HashTbl<T, KF, SwissTable, Hasher>:: ~HashTbl()
+{
+  release(table);
+  release(oldTable);
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+template < class K >
+uint64_t HashTbl<T, KF, SwissTable, Hasher>::hashOf(const K& key)
+{
+  return Hasher()(key);
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::allocate(Slots& slots, size_t capacity) THROWS(bad_alloc)
+{
+  // The trailing width - 1 bytes mirror the first ones so a group
+  // loaded near the end of the table wraps around without a branch
+  int8_t* ctrl = new int8_t[capacity + SwissGroup::width - 1];
+  try
+  {
+    slots.items = new T[capacity];
+  }
+  catch (bad_alloc)
+  {
+    delete[] ctrl;
+    throw;
+  }
+
+  memset(ctrl, SwissGroup::kEmpty, capacity + SwissGroup::width - 1);
+  slots.ctrl = ctrl;
+  slots.capacity = capacity;
+  slots.mask = capacity - 1;
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::release(Slots& slots)
+{
+  delete[] slots.ctrl;
+  delete[] slots.items;
+  slots.ctrl = 0;
+  slots.items = 0;
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::setCtrl(Slots& slots, size_t index, int8_t value)
+{
+  slots.ctrl[index] = value;
+  if (index < SwissGroup::width - 1)
+    slots.ctrl[slots.capacity + index] = value;
+}
+
+template < class T, class KF, class Hasher >
+template < class K >
+long HashTbl<T, KF, SwissTable, Hasher>::probe(const Slots& slots, const K& searchKey, uint64_t h)
+{
+  int8_t h2 = static_cast<int8_t>(h & 0x7f);
+  size_t pos = static_cast<size_t>(h >> 7) & slots.mask;
+
+  for (;;)
+  {
+    SwissGroup group(slots.ctrl + pos);
+    for (unsigned m = group.match(h2); m != 0; m &= m - 1)
+    {
+      size_t index = (pos + SwissGroup::lowestBit(m)) & slots.mask;
+      if (slots.items[index].getKey() == searchKey)
+        return static_cast<long>(index);
+    }
+    if (group.matchEmpty())
+      return -1;
+    pos = (pos + SwissGroup::width) & slots.mask;
+  }
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::place(Slots& slots, const T& newDataItem, uint64_t h)
+{
+  // Caller guarantees the key is absent and a slot is free
+  size_t pos = static_cast<size_t>(h >> 7) & slots.mask;
+
+  for (;;)
+  {
+    unsigned empty = SwissGroup(slots.ctrl + pos).matchEmpty();
+    if (empty)
+    {
+      size_t index = (pos + SwissGroup::lowestBit(empty)) & slots.mask;
+      slots.items[index] = newDataItem;
+      setCtrl(slots, index, static_cast<int8_t>(h & 0x7f));
+      return;
+    }
+    pos = (pos + SwissGroup::width) & slots.mask;
+  }
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::erase(Slots& slots, size_t hole)
+{
+  // Backward-shift deletion: walk the rest of the run and move back
+  // any item whose home slot does not lie between the hole and itself
+  for (size_t next = (hole + 1) & slots.mask; slots.ctrl[next] != SwissGroup::kEmpty; next = (next + 1) & slots.mask)
+  {
+    size_t nextHome = static_cast<size_t>(hashOf(slots.items[next].getKey()) >> 7) & slots.mask;
+    if (((next - nextHome) & slots.mask) >= ((next - hole) & slots.mask))
+    {
+      slots.items[hole] = slots.items[next];
+      setCtrl(slots, hole, slots.ctrl[next]);
+      hole = next;
+    }
+  }
+
+  slots.items[hole] = T();
+  setCtrl(slots, hole, SwissGroup::kEmpty);
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::startRehash(size_t newCapacity) THROWS(bad_alloc)
+{
+  Slots newTable;
+  allocate(newTable, newCapacity);
+
+  oldTable = table;
+  table = newTable;
+  migrated = 0;
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::migrate(int groupCount)
+{
+  if (oldTable.ctrl == 0)
+    return;
+
+  size_t stop = migrated + static_cast<size_t>(groupCount) * SwissGroup::width;
+  if (stop > oldTable.capacity || groupCount < 0)
+    stop = oldTable.capacity;
+
+  for (; migrated < stop; migrated++)
+  {
+    if (oldTable.ctrl[migrated] < 0)
+      continue;
+
+    const T& item = oldTable.items[migrated];
+    place(table, item, hashOf(item.getKey()));
+    setCtrl(oldTable, migrated, SwissGroup::kMoved);
+  }
+
+  if (migrated == oldTable.capacity)
+    release(oldTable);
+}
+
+template < class T, class KF, class Hasher >
+size_t HashTbl<T, KF, SwissTable, Hasher>::slotCount() const
+{
+  return table.capacity + (oldTable.ctrl != 0 ? oldTable.capacity - migrated : 0);
+}
+
+template < class T, class KF, class Hasher >
+const T* HashTbl<T, KF, SwissTable, Hasher>::slotAt(size_t index) const
+{
+  if (index < table.capacity)
+    return (table.ctrl[index] >= 0 ? &table.items[index] : 0);
+
+  index += migrated - table.capacity;
+  return (oldTable.ctrl[index] >= 0 ? &oldTable.items[index] : 0);
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+HashTbl<T, KF, SwissTable, Hasher>::const_iterator::const_iterator(const HashTbl* owner, size_t startIndex)
+  : table(owner), index(startIndex), item(0)
+{
+  skipEmpty();
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::const_iterator::skipEmpty()
+{
+  for (size_t end = table->slotCount(); index < end; index++)
+  {
+    item = table->slotAt(index);
+    if (item != 0)
+      return;
+  }
+  item = 0;
+}
+
+template < class T, class KF, class Hasher >
+typename HashTbl<T, KF, SwissTable, Hasher>::const_iterator HashTbl<T, KF, SwissTable, Hasher>::begin() const
+{
+  return const_iterator(this, 0);
+}
+
+template < class T, class KF, class Hasher >
+typename HashTbl<T, KF, SwissTable, Hasher>::const_iterator HashTbl<T, KF, SwissTable, Hasher>::end() const
+{
+  return const_iterator(this, slotCount());
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::insert(const T& newDataItem) THROWS(bad_alloc)
+{
+  // At least one slot must stay empty so every probe terminates
+  if (count + 1 > maxLoad * table.capacity || count + 1 >= table.capacity)
+  {
+    migrate(-1);
+    startRehash(table.capacity * 2);
+  }
+  migrate(kMigrateStep);
+
+  uint64_t h = hashOf(newDataItem.getKey());
+  long found = probe(table, newDataItem.getKey(), h);
+  if (found >= 0)
+  {
+    table.items[found] = newDataItem;
+    return;
+  }
+
+  if (oldTable.ctrl != 0)
+  {
+    found = probe(oldTable, newDataItem.getKey(), h);
+    if (found >= 0)
+    {
+      // Superseded: retire the old copy instead of moving it later
+      setCtrl(oldTable, found, SwissGroup::kMoved);
+      count--;
+    }
+  }
+
+  place(table, newDataItem, h);
+  count++;
+}
+
+template < class T, class KF, class Hasher >
+template < class InputIt >
+void HashTbl<T, KF, SwissTable, Hasher>::bulk_insert(InputIt first, InputIt last, int countHint) THROWS(bad_alloc)
+{
+  if (countHint <= 0)
+    countHint = countOf(first, last, typename iterator_traits<InputIt>::iterator_category());
+  if (countHint > 0)
+    reserve(static_cast<int>(count) + countHint);
+
+  for (; first != last; ++first)
+    insert(*first);
+}
+
+template < class T, class KF, class Hasher >
+template < class InputIt >
+int HashTbl<T, KF, SwissTable, Hasher>::countOf(InputIt, InputIt, input_iterator_tag)
+{
+  return 0;
+}
+
+template < class T, class KF, class Hasher >
+template < class InputIt >
+int HashTbl<T, KF, SwissTable, Hasher>::countOf(InputIt first, InputIt last, forward_iterator_tag)
+{
+  return static_cast<int>(distance(first, last));
+}
+
+template < class T, class KF, class Hasher >
+bool HashTbl<T, KF, SwissTable, Hasher>::remove(const KF& searchKey)
+{
+  migrate(kMigrateStep);
+
+  uint64_t h = hashOf(searchKey);
+  long found = probe(table, searchKey, h);
+  if (found >= 0)
+  {
+    erase(table, static_cast<size_t>(found));
+    count--;
+    return true;
+  }
+
+  if (oldTable.ctrl != 0)
+  {
+    found = probe(oldTable, searchKey, h);
+    if (found >= 0)
+    {
+      setCtrl(oldTable, found, SwissGroup::kMoved);
+      count--;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template < class T, class KF, class Hasher >
+bool HashTbl<T, KF, SwissTable, Hasher>::retrieve(const KF& searchKey, T& dataItem)
+{
+  const T* item = find(searchKey);
+
+  if (item == 0)
+    return false;
+
+  dataItem = *item;
+  return true;
+}
+
+template < class T, class KF, class Hasher >
+template < class K >
+const T* HashTbl<T, KF, SwissTable, Hasher>::find(const K& searchKey)
+{
+  migrate(kMigrateStep);
+
+  uint64_t h = hashOf(searchKey);
+  long found = probe(table, searchKey, h);
+  if (found >= 0)
+    return &table.items[found];
+
+  if (oldTable.ctrl != 0)
+  {
+    found = probe(oldTable, searchKey, h);
+    if (found >= 0)
+      return &oldTable.items[found];
+  }
+
+  return 0;
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::clear()
+{
+  for (size_t i = 0; i < table.capacity; i++)
+  {
+    if (table.ctrl[i] != SwissGroup::kEmpty)
+      table.items[i] = T();
+  }
+  memset(table.ctrl, SwissGroup::kEmpty, table.capacity + SwissGroup::width - 1);
+  release(oldTable);
+  count = 0;
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::reserve(int count) THROWS(bad_alloc)
+{
+  size_t needed = static_cast<size_t>(count / maxLoad) + 1;
+  size_t capacity = table.capacity;
+  while (capacity < needed)
+    capacity *= 2;
+
+  migrate(-1);
+  if (capacity > table.capacity)
+  {
+    startRehash(capacity);
+    migrate(-1);
+  }
+}
+
+template < class T, class KF, class Hasher >
+float HashTbl<T, KF, SwissTable, Hasher>::load_factor() const
+{
+  return static_cast<float>(count) / table.capacity;
+}
+
+template < class T, class KF, class Hasher >
+float HashTbl<T, KF, SwissTable, Hasher>::max_load_factor() const
+{
+  return maxLoad;
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::max_load_factor(float newMaxLoad)
+{
+  if (newMaxLoad > 0.0f)
+    maxLoad = newMaxLoad;
+}
+
+//--------------------------------------------------------------------
+
+template < class T, class KF, class Hasher >
+bool HashTbl<T, KF, SwissTable, Hasher>::isEmpty() const
+{
+  return (count == 0);
+}
+
+template < class T, class KF, class Hasher >
+bool HashTbl<T, KF, SwissTable, Hasher>::isFull() const
+{
+  // The slot array grows on demand; running out of memory surfaces
+  // as bad_alloc from insert
+  return false;
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::showStructure() const
+{
+  cout << "The Hash Table has the following entries" << endl;
+  for (size_t i = 0; i < table.capacity; i++)
+  {
+    cout << i << ": ";
+    if (table.ctrl[i] == SwissGroup::kEmpty)
+      cout << "_";
+    else
+      cout << table.items[i].getKey();
+    cout << endl;
+  }
+
+  if (oldTable.ctrl != 0)
+  {
+    cout << "Rehash in progress, entries not yet moved:" << endl;
+    for (size_t i = migrated; i < oldTable.capacity; i++)
+    {
+      if (oldTable.ctrl[i] >= 0)
+        cout << oldTable.items[i].getKey() << " ";
+    }
+    cout << endl;
+  }
+}
+
+template < class T, class KF, class Hasher >
+void HashTbl<T, KF, SwissTable, Hasher>::showDistribution() const
+{
+  // Number of 16-slot groups a successful lookup loads for each item
+  const int kLongest = 16;             // Longer probes share the last row
+  size_t histogram[kLongest + 1] = {};
+  size_t longest = 0;
+
+  for (size_t i = 0; i < table.capacity; i++)
+  {
+    if (table.ctrl[i] == SwissGroup::kEmpty)
+      continue;
+
+    size_t home = static_cast<size_t>(hashOf(table.items[i].getKey()) >> 7) & table.mask;
+    size_t groups = ((i - home) & table.mask) / SwissGroup::width + 1;
+    histogram[groups < kLongest ? groups : kLongest]++;
+    if (groups > longest)
+      longest = groups;
+  }
+
+  cout << "Probe lengths: " << count << " items in " << table.capacity
+       << " slots, load " << load_factor() << ", longest " << longest << " groups" << endl;
+  if (oldTable.ctrl != 0)
+    cout << "(rehash in progress, unmoved entries not counted)" << endl;
+  for (int groups = 1; groups <= kLongest; groups++)
+  {
+    if (histogram[groups] == 0)
+      continue;
+    cout << (groups < kLongest ? "  " : ">=") << groups << ": " << histogram[groups]
+         << " items (" << 100.0 * histogram[groups] / count << "%)" << endl;
+  }
+}
+
+#endif //SWISSTBL_H_
@@ -1,9 +1,15 @@
 
 #include "MiniList.hpp"
+#include "MiniAllocators.hpp"
 #include <iostream> // cout
 #include <ios>      // boolalpha
 #include <compare>  // <=>
 #include <vector>
+#include <chrono>   // steady_clock
+#include <random>   // mt19937
+#include <numeric>  // accumulate
+#include <memory_resource> // pmr
+#include <cctype>   // tolower
 
 #ifdef _DEBUG
 #define _CRTDBG_MAP_ALLOC
@@ -18,10 +24,21 @@ void printList(const MiniList<T>& list);
 void testMiniListCopyAndMoveSemantics();
 template <typename T>
 void fillListFromVector(MiniList<T>& list, const std::vector<T>& vec);
-template <typename T>
-bool compareListWithVector(const MiniList<T>& list, const std::vector<T>& vec);
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+bool compareListWithVector(const MiniList<T, ChunkSize, Links, Alloc>& list, const std::vector<T>& vec);
 void testSort();
 void testMergeSortedLists();
+void testUnrolledList();
+void testDoublyLinkedList();
+void testAllocators();
+void testCapacity();
+void testEmplace();
+void testAssignment();
+void testSpliceMerge();
+void testParallelSort();
+void testUniqueUnsorted();
+void testAdaptiveSort();
+void benchmarkScan();
 
 
 template <typename T>
@@ -109,6 +126,17 @@ int main()
     testMiniListComparison<int>();
     testSort();
     testMergeSortedLists();
+    testUnrolledList();
+    testDoublyLinkedList();
+    testAllocators();
+    testCapacity();
+    testEmplace();
+    testAssignment();
+    testSpliceMerge();
+    testParallelSort();
+    testUniqueUnsorted();
+    testAdaptiveSort();
+    benchmarkScan();
   }
 
 #ifdef _DEBUG
@@ -237,8 +265,8 @@ void fillListFromVector(MiniList<T>& list, const std::vector<T>& vec) {
 }
 
 // Helper function to compare MiniList with a vector
-template <typename T>
-bool compareListWithVector(const MiniList<T>& list, const std::vector<T>& vec) {
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+bool compareListWithVector(const MiniList<T, ChunkSize, Links, Alloc>& list, const std::vector<T>& vec) {
   auto it = list.begin();
   for (const auto& item : vec) {
     if (it == list.end() || *it != item) {
@@ -343,4 +371,858 @@ void testMergeSortedLists() {
 
   // Assertions to validate the merge
   assert(mergedList2.size() == 8); // Check if the merged list has the correct size
-}
\ No newline at end of file
+}
+
+// Drives a list and a std::vector through the same random operations,
+// checking they agree after each step
+template <typename List>
+void checkRandomOperations(unsigned seed, List list = List()) {
+  std::vector<int> reference;
+  std::mt19937 rng(seed);
+
+  for (int step = 0; step < 20000; ++step) {
+    int value = static_cast<int>(rng() % 50);
+    switch (rng() % 8) {
+    case 0:
+    case 1:
+      list.push_back(value);
+      reference.push_back(value);
+      break;
+    case 2:
+      list.push_front(value);
+      reference.insert(reference.begin(), value);
+      break;
+    case 3:
+      if (!reference.empty()) {
+        list.pop_back();
+        reference.pop_back();
+      }
+      break;
+    case 4:
+      if (!reference.empty()) {
+        list.pop_front();
+        reference.erase(reference.begin());
+      }
+      break;
+    case 5:
+      if (step % 20 == 0) {
+        list.sort();
+        std::stable_sort(reference.begin(), reference.end());
+        list.unique();
+        reference.erase(std::unique(reference.begin(), reference.end()), reference.end());
+      }
+      else if (step % 10 == 0) {
+        list.adaptive_sort();
+        std::stable_sort(reference.begin(), reference.end());
+        list.unique();
+        reference.erase(std::unique(reference.begin(), reference.end()), reference.end());
+      }
+      else if (step % 10 == 5) {
+        // Reassign to a fresh run, longer or shorter than what is there
+        std::vector<int> replacement(rng() % 400);
+        for (int& element : replacement) {
+          element = static_cast<int>(rng() % 50);
+        }
+        list.assign(replacement.begin(), replacement.end());
+        reference = replacement;
+      }
+      break;
+    default:
+      if (reference.size() > 300) {
+        list.clear();
+        reference.clear();
+      }
+      break;
+    }
+
+    assert(list.size() == reference.size());
+    assert(compareListWithVector(list, reference));
+    if (!reference.empty()) {
+      assert(list.front() == reference.front() && list.back() == reference.back());
+    }
+  }
+}
+
+void testUnrolledList() {
+  checkRandomOperations<UnrolledMiniList<int>>(7);
+  checkRandomOperations<MiniList<int, 3>>(7);   // short chunks exercise the node boundaries
+
+  MiniList<int, 3> odds;
+  MiniList<int, 3> evens;
+  for (int i = 0; i < 10; ++i) {
+    odds.push_back(2 * i + 1);
+    evens.push_back(2 * i);
+  }
+  MiniList<int, 3> merged = merged.merge(odds, evens);
+  assert(merged.size() == 20);
+  int expected = 0;
+  for (int value : merged) {
+    assert(value == expected++);
+  }
+
+  MiniList<int, 3> copy(merged);
+  assert((copy <=> merged) == std::strong_ordering::equal);
+  copy.pop_back();
+  assert((copy <=> merged) == std::strong_ordering::less);
+
+  std::cout << "Unrolled list tests passed." << std::endl;
+}
+
+template <typename Container>
+long long timeScans(const Container& container, int passes, std::chrono::microseconds& elapsed) {
+  long long sum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int pass = 0; pass < passes; ++pass) {
+    for (auto it = container.begin(); it != container.end(); ++it) {
+      sum += *it;
+    }
+  }
+  elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  return sum;
+}
+
+// Sums the same elements held one per node, unrolled, and in a vector
+void benchmarkScan() {
+  constexpr int kElements = 4000000;
+  constexpr int kPasses = 5;
+
+  MiniList<int> plain;
+  UnrolledMiniList<int> unrolled;
+  std::vector<int> vec;
+  std::mt19937 rng(1);
+  for (int i = 0; i < kElements; ++i) {
+    int value = static_cast<int>(rng() % 1000);
+    plain.push_back(value);
+    unrolled.push_back(value);
+    vec.push_back(value);
+  }
+
+  std::chrono::microseconds plainTime{}, unrolledTime{}, vecTime{};
+  long long plainSum = timeScans(plain, kPasses, plainTime);
+  long long unrolledSum = timeScans(unrolled, kPasses, unrolledTime);
+  long long vecSum = timeScans(vec, kPasses, vecTime);
+  assert(plainSum == vecSum && unrolledSum == vecSum);
+
+  std::cout << "\nScanning " << kElements << " ints, " << kPasses << " passes ("
+            << kUnrolledChunk<int> << " per unrolled node)\n";
+  std::cout << "MiniList:         " << plainTime.count() / 1000.0 << " ms\n";
+  std::cout << "UnrolledMiniList: " << unrolledTime.count() / 1000.0 << " ms\n";
+  std::cout << "std::vector:      " << vecTime.count() / 1000.0 << " ms\n";
+}
+
+template <typename List>
+std::chrono::microseconds timeDrainFromBack(int elements) {
+  List list;
+  for (int i = 0; i < elements; ++i) {
+    list.push_back(i);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = elements - 1; i >= 0; --i) {
+    assert(list.back() == i);
+    list.pop_back();
+  }
+  assert(list.empty());
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+void testDoublyLinkedList() {
+  checkRandomOperations<MiniList<int, 1, DoublyLinked>>(11);
+  checkRandomOperations<UnrolledMiniList<int, DoublyLinked>>(11);
+  checkRandomOperations<MiniList<int, 3, DoublyLinked>>(11);
+
+  constexpr int kElements = 20000;
+  std::cout << "\nDraining " << kElements << " ints with pop_back\n";
+  std::cout << "SinglyLinked: " << timeDrainFromBack<MiniList<int>>(kElements).count() / 1000.0 << " ms\n";
+  std::cout << "DoublyLinked: " << timeDrainFromBack<MiniList<int, 1, DoublyLinked>>(kElements).count() / 1000.0 << " ms\n";
+
+  std::cout << "Doubly linked list tests passed." << std::endl;
+}
+
+void testAllocators() {
+  {
+    MiniArena arena;
+    checkRandomOperations(13, MiniList<int, 1, SinglyLinked, ArenaAllocator<int>>(ArenaAllocator<int>(arena)));
+    checkRandomOperations(13, UnrolledMiniList<int, DoublyLinked, ArenaAllocator<int>>(ArenaAllocator<int>(arena)));
+
+    // Merged lists are built on the inputs' allocator
+    using ArenaList = MiniList<int, 1, SinglyLinked, ArenaAllocator<int>>;
+    std::vector<ArenaList> parts;
+    for (int part = 0; part < 3; ++part) {
+      ArenaList& list = parts.emplace_back(ArenaAllocator<int>(arena));
+      for (int i = part; i < 30; i += 3) {
+        list.push_back(i);
+      }
+    }
+    ArenaList pair = parts[0].merge(parts[0], parts[1]);
+    assert(pair.size() == 20 && pair.front() == 0 && pair.back() == 28);
+    assert(pair.get_allocator() == parts[0].get_allocator());
+    ArenaList all = ArenaList::merge_all(parts.begin(), parts.end());
+    assert(all.size() == 30 && all.front() == 0 && all.back() == 29 && parts[2].empty());
+  }
+  {
+    MiniPool pool;
+    checkRandomOperations(13, MiniList<int, 1, DoublyLinked, PoolAllocator<int>>(PoolAllocator<int>(pool)));
+    checkRandomOperations(13, MiniList<int, 3, SinglyLinked, PoolAllocator<int>>(PoolAllocator<int>(pool)));
+  }
+  {
+    std::pmr::unsynchronized_pool_resource resource;
+    using PmrList = MiniList<int, 1, SinglyLinked, std::pmr::polymorphic_allocator<int>>;
+    checkRandomOperations(13, PmrList(&resource));
+
+    // Assigning between lists on different resources copies the elements
+    std::pmr::monotonic_buffer_resource other;
+    PmrList a(&resource);
+    PmrList b(&other);
+    for (int i = 0; i < 100; ++i) {
+      a.push_back(i);
+    }
+    b = a;
+    assert(b.size() == 100 && b.get_allocator().resource() == &other);
+    assert((a <=> b) == std::strong_ordering::equal);
+  }
+  {
+    // Non-trivial elements still get destroyed when an arena list is cleared
+    MiniArena arena;
+    MiniList<std::string, 1, SinglyLinked, ArenaAllocator<std::string>> names{ ArenaAllocator<std::string>(arena) };
+    for (int i = 0; i < 1000; ++i) {
+      names.push_back(std::string(40, static_cast<char>('a' + i % 26)));
+    }
+    auto copy = names;
+    names.clear();
+    assert(names.empty() && copy.size() == 1000 && copy.back() == std::string(40, 'a' + 999 % 26));
+  }
+
+  std::cout << "Allocator tests passed." << std::endl;
+}
+void testCapacity() {
+  MiniList<int> buffer;
+  assert(buffer.capacity() == MiniList<int>::kUnbounded && buffer.max_size() > 1000);
+  const std::size_t emptyBytes = buffer.memory_usage();
+
+  buffer.set_capacity(5);
+  for (int i = 0; i < 5; ++i) {
+    assert(buffer.try_push_back(i));
+  }
+  assert(buffer.full() && !buffer.try_push_back(5) && !buffer.try_push_front(-1));
+  bool threw = false;
+  try {
+    buffer.push_back(5);
+  }
+  catch (const std::runtime_error&) {
+    threw = true;
+  }
+  assert(threw && buffer.size() == 5 && buffer.back() == 4);
+  assert(buffer.memory_usage() > emptyBytes);
+
+  // Popping makes room again
+  buffer.pop_front();
+  buffer.push_back(5);
+  assert(buffer.full() && buffer.front() == 1 && buffer.back() == 5);
+
+  threw = false;
+  try {
+    buffer.set_capacity(3);
+  }
+  catch (const std::runtime_error&) {
+    threw = true;
+  }
+  assert(threw && buffer.capacity() == 5);
+
+  // The limit travels with copies
+  MiniList<int> copy = buffer;
+  assert(copy.capacity() == 5 && copy.full());
+
+  buffer.clear();
+  assert(buffer.memory_usage() == emptyBytes && !buffer.full());
+
+  // Unrolled nodes hold many elements each, so the bytes per element drop
+  UnrolledMiniList<int> unrolled;
+  MiniList<int> plain;
+  for (int i = 0; i < 10000; ++i) {
+    unrolled.push_back(i);
+    plain.push_back(i);
+  }
+  std::cout << "\nBytes held for 10000 ints: plain " << plain.memory_usage()
+            << ", unrolled " << unrolled.memory_usage() << '\n';
+  assert(unrolled.memory_usage() < plain.memory_usage());
+
+  std::cout << "Capacity tests passed." << std::endl;
+}
+
+/* Counts how a payload gets into and out of a list */
+struct Tracked
+{
+  static inline int copies = 0;
+  static inline int moves = 0;
+  static inline int alive = 0;
+
+  std::string payload;
+
+  explicit Tracked(std::string s) : payload(std::move(s)) { ++alive; }
+  Tracked(const Tracked& other) : payload(other.payload) { ++copies; ++alive; }
+  Tracked(Tracked&& other) noexcept : payload(std::move(other.payload)) { ++moves; ++alive; }
+  Tracked& operator=(const Tracked& other) { payload = other.payload; ++copies; return *this; }
+  Tracked& operator=(Tracked&& other) noexcept { payload = std::move(other.payload); ++moves; return *this; }
+  ~Tracked() { --alive; }
+};
+
+template <typename List>
+void checkEmplace() {
+  Tracked::copies = Tracked::moves = 0;
+  {
+    List list;
+    for (int i = 0; i < 100; ++i) {
+      list.emplace_back(std::string(64, static_cast<char>('a' + i % 26)));
+      list.emplace_front("front " + std::to_string(i));
+    }
+    list.push_back(Tracked("moved in"));
+    assert(Tracked::copies == 0);
+
+    // Accessors hand back the stored element, not a copy
+    list.back().payload += "!";
+    assert(list.back().payload == "moved in!" && list.front().payload == "front 99");
+    const List& view = list;
+    assert(&view.front() == &list.front() && Tracked::copies == 0);
+
+    Tracked taken = std::move(list.front());
+    list.pop_front();
+    list.pop_back();
+    assert(taken.payload == "front 99" && list.size() == 199 && Tracked::copies == 0);
+
+    // Copying the list is the one place elements get copied
+    List copy = list;
+    assert(Tracked::copies == 199);
+    assert(copy.front().payload == "front 98");
+  }
+  assert(Tracked::alive == 0);
+}
+
+void testEmplace() {
+  checkEmplace<MiniList<Tracked>>();
+  checkEmplace<MiniList<Tracked, 1, DoublyLinked>>();
+  checkEmplace<UnrolledMiniList<Tracked>>();
+  checkEmplace<MiniList<Tracked, 3, DoublyLinked>>();
+
+  // Pushing an element of the list itself is safe, even into an unrolled head
+  UnrolledMiniList<std::string> names;
+  names.push_back("first");
+  names.push_back("second");
+  names.push_front(names.back());
+  names.push_back(names.front());
+  assert(names.size() == 4 && names.front() == "second" && names.back() == "second");
+
+  // Arena lists build strings in place too, and still destroy them on clear
+  MiniArena arena;
+  MiniList<std::string, 4, SinglyLinked, ArenaAllocator<std::string>> words{ ArenaAllocator<std::string>(arena) };
+  for (int i = 0; i < 50; ++i) {
+    words.emplace_back(100, static_cast<char>('a' + i % 26));
+  }
+  assert(words.back() == std::string(100, 'a' + 49 % 26));
+  words.clear();
+
+  std::cout << "Emplace tests passed." << std::endl;
+}
+
+template <typename List>
+void checkAssignmentReusesNodes() {
+  List big;
+  List small;
+  for (int i = 0; i < 1000; ++i) {
+    big.push_back(i);
+  }
+  for (int i = 0; i < 600; ++i) {
+    small.push_back(-i);
+  }
+
+  // Shrinking keeps the leading nodes and frees the rest
+  List target = big;
+  const int* firstSlot = &target.front();
+  target = small;
+  assert(&target.front() == firstSlot && (target <=> small) == std::strong_ordering::equal);
+  assert(target.memory_usage() <= big.memory_usage() && target.back() == -599);
+
+  // Growing keeps all the nodes there were and appends
+  target = big;
+  assert(&target.front() == firstSlot && (target <=> big) == std::strong_ordering::equal);
+
+  // Assigning to itself or from an empty list
+  const List& alias = target;
+  target = alias;
+  assert(target.size() == 1000);
+  target = List();
+  assert(target.empty() && target.memory_usage() == List().memory_usage());
+
+  // Moving hands the nodes over whole
+  target = big;
+  firstSlot = &target.front();
+  List moved;
+  moved = std::move(target);
+  assert(&moved.front() == firstSlot && target.empty() && moved.size() == 1000);
+}
+
+void testAssignment() {
+  checkAssignmentReusesNodes<MiniList<int>>();
+  checkAssignmentReusesNodes<MiniList<int, 1, DoublyLinked>>();
+  checkAssignmentReusesNodes<UnrolledMiniList<int>>();
+  checkAssignmentReusesNodes<MiniList<int, 3, DoublyLinked>>();
+
+  std::vector<std::string> words{ "alpha", "beta", "gamma", "delta" };
+  MiniList<std::string, 3> list;
+  list.assign(words.begin(), words.end());
+  list.assign(words.begin() + 1, words.end() - 1);
+  assert(list.size() == 2 && list.front() == "beta" && list.back() == "gamma");
+  list.assign(words.begin(), words.begin());
+  assert(list.empty());
+
+  // Different pmr resources: elements are copied or moved, never the nodes
+  std::pmr::unsynchronized_pool_resource first;
+  std::pmr::unsynchronized_pool_resource second;
+  MiniList<std::pmr::string, 1, SinglyLinked, std::pmr::polymorphic_allocator<std::pmr::string>> a(&first);
+  MiniList<std::pmr::string, 1, SinglyLinked, std::pmr::polymorphic_allocator<std::pmr::string>> b(&second);
+  a.push_back("a string long enough to live on the heap");
+  b = std::move(a);
+  assert(b.size() == 1 && b.front().get_allocator().resource() == &second && a.empty());
+
+  // Reassigning a large list over and over: copy-and-swap built a whole new
+  // list each time, this overwrites in place
+  MiniList<int> source;
+  for (int i = 0; i < 100000; ++i) {
+    source.push_back(i);
+  }
+  MiniList<int> target;
+  const auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < 50; ++round) {
+    target = source;
+  }
+  const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+  std::cout << "\n50 assignments of 100000 ints: " << elapsed.count() << " ms\n";
+
+  std::cout << "Assignment tests passed." << std::endl;
+}
+
+template <typename List>
+void checkSpliceMerge() {
+  std::mt19937 rng(17);
+
+  // Pairwise: stable, and the nodes of this list stay where they were
+  List lhs;
+  List rhs;
+  for (int i = 0; i < 500; ++i) {
+    lhs.push_back(static_cast<int>(rng() % 100));
+    rhs.push_back(static_cast<int>(rng() % 100));
+  }
+  lhs.sort();
+  rhs.sort();
+  std::vector<int> reference(lhs.begin(), lhs.end());
+  reference.insert(reference.end(), rhs.begin(), rhs.end());
+  std::stable_sort(reference.begin(), reference.end());
+  lhs.merge(std::move(rhs));
+  assert(rhs.empty() && compareListWithVector(lhs, reference));
+  assert(lhs.front() == reference.front() && lhs.back() == reference.back());
+
+  // Splice appends whole
+  List tail;
+  for (int i = 0; i < 50; ++i) {
+    tail.push_back(1000 + i);
+    reference.push_back(1000 + i);
+  }
+  lhs.splice(std::move(tail));
+  lhs.splice(List());
+  assert(tail.empty() && compareListWithVector(lhs, reference));
+  lhs.push_back(2000);
+  lhs.pop_back();
+  assert(lhs.back() == 1049);
+
+  // k-way merge of many sorted lists, some of them empty
+  std::vector<List> parts(40);
+  std::vector<int> all;
+  for (std::size_t p = 0; p < parts.size(); ++p) {
+    std::vector<int> values(p % 7 == 0 ? 0 : rng() % 60);
+    for (int& value : values) {
+      value = static_cast<int>(rng() % 500);
+    }
+    std::sort(values.begin(), values.end());
+    for (int value : values) {
+      parts[p].push_back(value);
+    }
+    all.insert(all.end(), values.begin(), values.end());
+  }
+  std::sort(all.begin(), all.end());
+  List merged = List::merge_all(parts.begin(), parts.end());
+  assert(compareListWithVector(merged, all));
+  for (const List& part : parts) {
+    assert(part.empty());
+  }
+}
+
+void testSpliceMerge() {
+  checkSpliceMerge<MiniList<int>>();
+  checkSpliceMerge<MiniList<int, 1, DoublyLinked>>();
+  checkSpliceMerge<UnrolledMiniList<int>>();
+  checkSpliceMerge<MiniList<int, 3, DoublyLinked>>();
+
+  // The relinked nodes are the original ones
+  MiniList<int> evens{};
+  MiniList<int> odds{};
+  for (int i = 0; i < 10; ++i) {
+    evens.push_back(2 * i);
+    odds.push_back(2 * i + 1);
+  }
+  const int* one = &odds.front();
+  evens.merge(std::move(odds));
+  auto it = evens.begin();
+  ++it;
+  assert(&*it == one && evens.size() == 20);
+
+  // k-way merge is stable: equal keys keep the order of their lists
+  using Tagged = std::pair<int, int>; // (key, list), compared on key alone
+  struct ByKey
+  {
+    Tagged value;
+    bool operator<(const ByKey& other) const { return value.first < other.value.first; }
+  };
+  std::vector<MiniList<ByKey>> tagged(5);
+  for (int list = 0; list < 5; ++list) {
+    for (int key = 0; key < 4; ++key) {
+      tagged[list].push_back(ByKey{ Tagged(key, list) });
+    }
+  }
+  MiniList<ByKey> stable = MiniList<ByKey>::merge_all(tagged.begin(), tagged.end());
+  int expected = 0;
+  for (const ByKey& element : stable) {
+    assert(element.value == Tagged(expected / 5, expected % 5));
+    ++expected;
+  }
+
+  // Different pmr resources: elements move across, nothing is copied
+  std::pmr::unsynchronized_pool_resource first;
+  std::pmr::unsynchronized_pool_resource second;
+  using PmrList = MiniList<int, 1, SinglyLinked, std::pmr::polymorphic_allocator<int>>;
+  PmrList a(&first);
+  PmrList b(&second);
+  for (int i = 0; i < 100; ++i) {
+    (i % 2 ? a : b).push_back(i);
+  }
+  a.merge(std::move(b));
+  assert(a.size() == 100 && b.empty() && a.front() == 0 && a.back() == 99);
+
+  // Merging a few hundred sorted partial results
+  constexpr int kParts = 100;
+  constexpr int kEach = 500;
+  std::vector<MiniList<int>> parts(kParts);
+  for (int p = 0; p < kParts; ++p) {
+    for (int i = 0; i < kEach; ++i) {
+      parts[p].push_back(i * kParts + p);
+    }
+  }
+  std::vector<MiniList<int>> copies = parts;
+
+  auto start = std::chrono::steady_clock::now();
+  MiniList<int> pairwise;
+  for (const MiniList<int>& part : copies) {
+    pairwise = pairwise.merge(pairwise, part);
+  }
+  const auto copyingMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+  start = std::chrono::steady_clock::now();
+  MiniList<int> kway = MiniList<int>::merge_all(parts.begin(), parts.end());
+  const auto heapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+  assert((kway <=> pairwise) == std::strong_ordering::equal);
+  std::cout << "\nMerging " << kParts << " sorted lists of " << kEach << " ints\n";
+  std::cout << "Copying pairwise merge: " << copyingMs.count() << " ms\n";
+  std::cout << "merge_all (heap, relink): " << heapMs.count() << " ms\n";
+
+  std::cout << "Splice and merge tests passed." << std::endl;
+}
+
+template <typename List>
+void checkParallelSort(std::size_t elements, std::size_t threads) {
+  std::mt19937 rng(static_cast<unsigned>(elements + threads));
+  List list;
+  std::vector<int> reference;
+  for (std::size_t i = 0; i < elements; ++i) {
+    int value = static_cast<int>(rng() % 100000);
+    list.push_back(value);
+    reference.push_back(value);
+  }
+  list.parallel_sort(threads);
+  std::sort(reference.begin(), reference.end());
+  assert(list.size() == elements && compareListWithVector(list, reference));
+  if (!reference.empty()) {
+    assert(list.front() == reference.front() && list.back() == reference.back());
+    list.pop_back();
+    list.push_back(-1);
+    assert(list.back() == -1);
+  }
+}
+
+void testParallelSort() {
+  const std::size_t big = MiniList<int>::kParallelSortCutoff * 3 + 7;
+  for (std::size_t threads : { 1, 2, 3, 4, 7 }) {
+    checkParallelSort<MiniList<int>>(big, threads);
+    checkParallelSort<MiniList<int, 1, DoublyLinked>>(big, threads);
+    checkParallelSort<UnrolledMiniList<int>>(big, threads);
+  }
+  checkParallelSort<MiniList<int>>(0, 4);
+  checkParallelSort<MiniList<int>>(1000, 4); // below the cutoff
+
+  // Stable, as sort() is
+  struct ByKey
+  {
+    int key;
+    int order;
+    bool operator<(const ByKey& other) const { return key < other.key; }
+    bool operator<=(const ByKey& other) const { return key <= other.key; }
+  };
+  MiniList<ByKey> keyed;
+  UnrolledMiniList<ByKey> unrolledKeyed;
+  for (int i = 0; i < static_cast<int>(big); ++i) {
+    keyed.push_back({ (i * 7919) % 64, i });
+    unrolledKeyed.push_back({ (i * 7919) % 64, i });
+  }
+  keyed.parallel_sort(4);
+  unrolledKeyed.parallel_sort(4);
+  auto isStable = [](const auto& list) {
+    const ByKey* previous = nullptr;
+    for (const ByKey& element : list) {
+      if (previous && (previous->key > element.key || (previous->key == element.key && previous->order > element.order))) {
+        return false;
+      }
+      previous = &element;
+    }
+    return true;
+  };
+  assert(isStable(keyed) && isStable(unrolledKeyed));
+
+  // A comparison that throws on a worker thread reaches the caller, and
+  // every element is still in the list
+  struct Poisoned
+  {
+    int value;
+    bool operator<(const Poisoned& other) const {
+      if (value < 0 || other.value < 0) {
+        throw std::runtime_error("poisoned comparison");
+      }
+      return value < other.value;
+    }
+  };
+  UnrolledMiniList<Poisoned> poisoned;
+  long long sum = 0;
+  for (int i = 0; i < static_cast<int>(big); ++i) {
+    poisoned.push_back({ (i * 7919) % 1000 });
+    sum += (i * 7919) % 1000;
+  }
+  poisoned.push_back({ -1 }); // in the last run, sorted off the calling thread
+  bool threw = false;
+  try {
+    poisoned.parallel_sort(4);
+  }
+  catch (const std::runtime_error&) {
+    threw = true;
+  }
+  long long after = 0;
+  for (const Poisoned& element : poisoned) {
+    after += element.value;
+  }
+  assert(threw && poisoned.size() == big + 1 && after == sum - 1);
+
+  // Plain lists sort each run with noexcept sort(), so here the throw
+  // comes from the merge rounds: 1000 and 1001 sort to the back of the
+  // first two runs and only meet when those are merged, late
+  struct PoisonedPair
+  {
+    int value;
+    bool operator<(const PoisonedPair& other) const {
+      if (value + other.value == 2001) {
+        throw std::runtime_error("poisoned comparison");
+      }
+      return value < other.value;
+    }
+    bool operator<=(const PoisonedPair& other) const {
+      return !(other < *this);
+    }
+  };
+  MiniList<PoisonedPair> pair;
+  sum = 0;
+  for (int i = 0; i < static_cast<int>(big); ++i) {
+    if (i == 0) {
+      pair.push_back({ 1000 }); // first run
+    }
+    else if (i == static_cast<int>(big) * 3 / 8) {
+      pair.push_back({ 1001 }); // second run
+    }
+    pair.push_back({ (i * 7919) % 1000 });
+    sum += (i * 7919) % 1000;
+  }
+  threw = false;
+  try {
+    pair.parallel_sort(4);
+  }
+  catch (const std::runtime_error&) {
+    threw = true;
+  }
+  after = 0;
+  for (const PoisonedPair& element : pair) {
+    after += element.value;
+  }
+  assert(threw && pair.size() == big + 2 && after == sum + 2001);
+
+  std::cout << "Parallel sort tests passed." << std::endl;
+}
+
+template <typename List>
+void checkUniqueUnsorted(unsigned seed, int distinct) {
+  std::mt19937 rng(seed);
+  List list;
+  std::vector<int> reference;
+  std::vector<bool> seen(distinct, false);
+  for (int i = 0; i < 5000; ++i) {
+    int value = static_cast<int>(rng() % distinct);
+    list.push_back(value);
+    if (!seen[value]) {
+      seen[value] = true;
+      reference.push_back(value);
+    }
+  }
+  list.unique_unsorted();
+  assert(list.size() == reference.size() && compareListWithVector(list, reference));
+  assert(list.front() == reference.front() && list.back() == reference.back());
+  list.push_back(-1);
+  list.pop_back();
+  assert(list.back() == reference.back());
+}
+
+void testUniqueUnsorted() {
+  for (int distinct : { 1, 7, 1000, 100000 }) {
+    checkUniqueUnsorted<MiniList<int>>(19, distinct);
+    checkUniqueUnsorted<MiniList<int, 1, DoublyLinked>>(19, distinct);
+    checkUniqueUnsorted<UnrolledMiniList<int>>(19, distinct);
+    checkUniqueUnsorted<MiniList<int, 3, DoublyLinked>>(19, distinct);
+  }
+
+  MiniList<std::string> words;
+  for (const char* word : { "pear", "apple", "pear", "fig", "apple", "plum", "fig" }) {
+    words.push_back(word);
+  }
+  words.unique_unsorted();
+  assert(words.size() == 4 && words.front() == "pear" && words.back() == "plum");
+
+  // Custom hash and equality: case-insensitive
+  UnrolledMiniList<std::string> names;
+  for (const char* name : { "Ada", "ada", "Grace", "ADA", "grace", "Linus" }) {
+    names.push_back(name);
+  }
+  auto lower = [](std::string s) {
+    for (char& c : s) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return s;
+  };
+  names.unique_unsorted([&](const std::string& s) { return std::hash<std::string>()(lower(s)); },
+                        [&](const std::string& a, const std::string& b) { return lower(a) == lower(b); });
+  assert(names.size() == 3 && names.front() == "Ada" && names.back() == "Linus");
+
+  // Against sorting just to dedupe
+  constexpr int kElements = 200000;
+  std::mt19937 rng(23);
+  MiniList<int> hashed;
+  for (int i = 0; i < kElements; ++i) {
+    hashed.push_back(static_cast<int>(rng() % 5000));
+  }
+  MiniList<int> sorted = hashed;
+
+  auto start = std::chrono::steady_clock::now();
+  hashed.unique_unsorted();
+  const auto hashMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+  start = std::chrono::steady_clock::now();
+  sorted.sort();
+  sorted.unique();
+  const auto sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+  assert(hashed.size() == sorted.size());
+
+  std::cout << "\nDeduplicating " << kElements << " ints (5000 distinct)\n";
+  std::cout << "unique_unsorted: " << hashMs.count() << " ms\n";
+  std::cout << "sort + unique:   " << sortMs.count() << " ms\n";
+
+  std::cout << "unique_unsorted tests passed." << std::endl;
+}
+
+/* Sort inputs of various shapes: values carry their input position so
+ * stability can be checked */
+struct Keyed
+{
+  int key;
+  int order;
+  bool operator<(const Keyed& other) const { return key < other.key; }
+  bool operator<=(const Keyed& other) const { return key <= other.key; }
+};
+
+template <typename List>
+void checkAdaptiveSort(const std::vector<int>& keys) {
+  List list;
+  std::vector<Keyed> reference;
+  for (int i = 0; i < static_cast<int>(keys.size()); ++i) {
+    list.push_back({ keys[i], i });
+    reference.push_back({ keys[i], i });
+  }
+  list.adaptive_sort();
+  std::stable_sort(reference.begin(), reference.end());
+
+  assert(list.size() == reference.size());
+  auto expected = reference.begin();
+  for (const Keyed& element : list) {
+    assert(element.key == expected->key && element.order == expected->order);
+    ++expected;
+  }
+  if (!reference.empty()) {
+    assert(list.back().order == reference.back().order);
+    list.push_back({ -1, -1 });
+    list.pop_back();
+    assert(list.back().order == reference.back().order);
+  }
+}
+
+void testAdaptiveSort() {
+  std::mt19937 rng(29);
+  std::vector<std::vector<int>> shapes;
+  shapes.push_back({});
+  shapes.push_back({ 5 });
+  for (int n : { 2, 3, 100, 5000 }) {
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    shapes.push_back(sorted);
+    shapes.push_back(std::vector<int>(sorted.rbegin(), sorted.rend()));
+
+    std::vector<int> random(n);
+    std::vector<int> fewUnique(n);
+    std::vector<int> sawtooth(n);
+    std::vector<int> descendingTies(n);
+    for (int i = 0; i < n; ++i) {
+      random[i] = static_cast<int>(rng() % 1000);
+      fewUnique[i] = static_cast<int>(rng() % 3);
+      sawtooth[i] = i % 37;
+      descendingTies[i] = (n - i) / 4; // descending, but not strictly
+    }
+    shapes.push_back(random);
+    shapes.push_back(fewUnique);
+    shapes.push_back(sawtooth);
+    shapes.push_back(descendingTies);
+
+    std::vector<int> nearly = sorted; // a few out-of-order appends
+    for (int i = 0; i < n / 50; ++i) {
+      std::swap(nearly[rng() % n], nearly[rng() % n]);
+    }
+    shapes.push_back(nearly);
+  }
+
+  for (const std::vector<int>& keys : shapes) {
+    checkAdaptiveSort<MiniList<Keyed>>(keys);
+    checkAdaptiveSort<MiniList<Keyed, 1, DoublyLinked>>(keys);
+    checkAdaptiveSort<UnrolledMiniList<Keyed>>(keys);
+    checkAdaptiveSort<MiniList<Keyed, 3, DoublyLinked>>(keys);
+  }
+
+  std::cout << "Adaptive sort tests passed." << std::endl;
+}
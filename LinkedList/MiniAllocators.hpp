@@ -0,0 +1,206 @@
+/****
+ *
+ * Node allocators for MiniList (or any allocator-aware container)
+ *
+ * MiniArena:  monotonic arena. Allocation bumps a pointer through large
+ *             blocks; nothing is freed until release() or destruction.
+ * MiniPool:   free-list pool of fixed-size slots carved from blocks.
+ *             Freed slots are reused first.
+ *
+ * ArenaAllocator<T> and PoolAllocator<T> are the std-style allocator
+ * handles that point at one of them. The arena or pool must outlive every
+ * container using it. Neither is thread safe.
+ */
+
+#pragma once
+#ifndef MINIALLOCATORS_HPP_
+#define MINIALLOCATORS_HPP_
+
+#include <cstddef>     // size_t, max_align_t
+#include <cstdint>     // uintptr_t
+#include <new>         // bad_alloc, operator new
+#include <type_traits> // true_type
+
+class MiniArena
+{
+private:
+  struct Block
+  {
+    Block* next;
+  };
+
+  Block* blocks_;      // most recent first
+  char* cursor_;       // next free byte in the current block
+  char* limit_;        // end of the current block
+  std::size_t blockSize_;
+
+public:
+  explicit MiniArena(std::size_t blockSize = std::size_t{ 1 } << 20) noexcept
+    : blocks_(nullptr), cursor_(nullptr), limit_(nullptr), blockSize_(blockSize) {}
+  ~MiniArena() { release(); }
+
+  MiniArena(const MiniArena&) = delete;
+  MiniArena& operator=(const MiniArena&) = delete;
+
+  void* allocate(std::size_t bytes, std::size_t alignment)
+  {
+    std::uintptr_t start = (reinterpret_cast<std::uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+    if (cursor_ == nullptr || start + bytes > reinterpret_cast<std::uintptr_t>(limit_))
+    {
+      grow(bytes + alignment);
+      start = (reinterpret_cast<std::uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+    }
+    cursor_ = reinterpret_cast<char*>(start + bytes);
+    return reinterpret_cast<void*>(start);
+  }
+
+  /* Frees every block at once; all memory handed out becomes invalid */
+  void release() noexcept
+  {
+    while (blocks_ != nullptr)
+    {
+      Block* next = blocks_->next;
+      ::operator delete(blocks_);
+      blocks_ = next;
+    }
+    cursor_ = limit_ = nullptr;
+  }
+
+private:
+  void grow(std::size_t atLeast)
+  {
+    std::size_t size = sizeof(Block) + (atLeast > blockSize_ ? atLeast : blockSize_);
+    Block* block = static_cast<Block*>(::operator new(size));
+    block->next = blocks_;
+    blocks_ = block;
+    cursor_ = reinterpret_cast<char*>(block + 1);
+    limit_ = reinterpret_cast<char*>(block) + size;
+  }
+};
+
+class MiniPool
+{
+private:
+  struct Slot
+  {
+    Slot* next;
+  };
+
+  MiniArena blocks_;     // slots are carved from here and never given back
+  Slot* free_;
+  std::size_t slotSize_; // both fixed by the first allocation
+  std::size_t slotAlign_;
+
+public:
+  explicit MiniPool(std::size_t blockSize = std::size_t{ 1 } << 20) noexcept
+    : blocks_(blockSize), free_(nullptr), slotSize_(0), slotAlign_(alignof(Slot)) {}
+
+  MiniPool(const MiniPool&) = delete;
+  MiniPool& operator=(const MiniPool&) = delete;
+
+  /* Requests that do not fit the slot size go straight to operator new */
+  void* allocate(std::size_t bytes, std::size_t alignment)
+  {
+    if (slotSize_ == 0)
+    {
+      slotAlign_ = alignment > slotAlign_ ? alignment : slotAlign_;
+      slotSize_ = (bytes < sizeof(Slot) ? sizeof(Slot) : bytes);
+      slotSize_ = (slotSize_ + slotAlign_ - 1) & ~(slotAlign_ - 1);
+    }
+    if (bytes > slotSize_ || alignment > slotAlign_)
+    {
+      return ::operator new(bytes);
+    }
+
+    if (free_ != nullptr)
+    {
+      Slot* slot = free_;
+      free_ = slot->next;
+      return slot;
+    }
+    return blocks_.allocate(slotSize_, slotAlign_);
+  }
+
+  void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+  {
+    if (bytes > slotSize_ || alignment > slotAlign_)
+    {
+      ::operator delete(p);
+      return;
+    }
+
+    Slot* slot = static_cast<Slot*>(p);
+    slot->next = free_;
+    free_ = slot;
+  }
+};
+
+/* Allocator handle for a MiniArena. deallocate() does nothing, so a
+ * container may drop trivially destructible elements without visiting
+ * them (releases_in_bulk). */
+template <typename T>
+class ArenaAllocator
+{
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using releases_in_bulk = std::true_type;
+
+  explicit ArenaAllocator(MiniArena& arena) noexcept : arena_(&arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T*, std::size_t) noexcept {}
+
+  friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator& rhs) noexcept {
+    return lhs.arena_ == rhs.arena_;
+  }
+
+private:
+  MiniArena* arena_;
+
+  template <typename U>
+  friend class ArenaAllocator;
+};
+
+/* Allocator handle for a MiniPool */
+template <typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  explicit PoolAllocator(MiniPool& pool) noexcept : pool_(&pool) {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool_) {}
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(pool_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    pool_->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  friend bool operator==(const PoolAllocator& lhs, const PoolAllocator& rhs) noexcept {
+    return lhs.pool_ == rhs.pool_;
+  }
+
+private:
+  MiniPool* pool_;
+
+  template <typename U>
+  friend class PoolAllocator;
+};
+
+#endif // MINIALLOCATORS_HPP_
\ No newline at end of file
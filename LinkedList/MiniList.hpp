@@ -9,34 +9,184 @@
 #ifndef MINILIST_HPP_
 #define MINILIST_HPP_
 
-#include <utility> // swap
+#include <utility> // swap, forward
 #include <cstdlib>   // size_t
-#include <exception> // bad_alloc
+#include <cstdint>   // uint32_t
+#include <exception> // bad_alloc, exception_ptr
 #include <stdexcept> // runtime_error
 #include <string>
 #include <compare>   // <=>
+#include <algorithm> // move, move_backward, stable_sort
+#include <limits>    // numeric_limits
+#include <type_traits> // is_same_v
+#include <memory>    // allocator, allocator_traits
+#include <vector>
+#include <iterator>  // forward_iterator_tag
+#include <thread>
+#include <system_error>
+#include <functional> // hash, equal_to
+#include <array>
+
+/* Link policies for MiniList. SinglyLinked nodes carry only a next pointer;
+ * DoublyLinked nodes also point back, which makes pop_back O(1) at the cost
+ * of one pointer per node. */
+struct SinglyLinked {};
+struct DoublyLinked {};
+
+/* Base of MiniList's node: empty (and so free) unless Doubly */
+template <typename Node, bool Doubly>
+struct MiniListPriorLink {};
+
+template <typename Node>
+struct MiniListPriorLink<Node, true>
+{
+  Node* prior;
+};
 
-template <typename T>
+/* True when Alloc's deallocate does nothing (see ArenaAllocator in
+ * MiniAllocators.hpp), so a list of trivially destructible elements can
+ * drop all its nodes without visiting them */
+template <typename Alloc, typename = void>
+struct MiniListBulkRelease : std::false_type {};
+
+template <typename Alloc>
+struct MiniListBulkRelease<Alloc, std::void_t<typename Alloc::releases_in_bulk>> : Alloc::releases_in_bulk {};
+
+/* Open-addressing set of pointers to elements, for unique_unsorted().
+ * Linear probing over a power-of-two table kept at most half full; the
+ * hash is scrambled (Fibonacci hashing) since std::hash of an integer is
+ * often the integer itself. The elements pointed to must stay put. */
+template <typename T, typename Hash, typename KeyEqual>
+class MiniListSeenSet
+{
+private:
+  std::vector<const T*> slots_;
+  std::size_t used_;
+  unsigned shift_;   // 64 - log2(slots_.size())
+  Hash hash_;
+  KeyEqual equal_;
+
+  std::size_t home(const T& value) const
+  {
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(hash_(value)) * 0x9E3779B97F4A7C15ull) >> shift_);
+  }
+
+  void grow()
+  {
+    std::vector<const T*> old(slots_.size() * 2, nullptr);
+    old.swap(slots_);
+    --shift_;
+    for (const T* element : old) {
+      if (element != nullptr) {
+        std::size_t slot = home(*element);
+        while (slots_[slot] != nullptr) {
+          slot = (slot + 1) & (slots_.size() - 1);
+        }
+        slots_[slot] = element;
+      }
+    }
+  }
+
+public:
+  MiniListSeenSet(const Hash& hash, const KeyEqual& equal)
+    : slots_(16, nullptr), used_(0), shift_(60), hash_(hash), equal_(equal) {}
+
+  /* Slot where value is, or where it would go */
+  std::size_t find(const T& value)
+  {
+    if (2 * (used_ + 1) > slots_.size()) {
+      grow();
+    }
+    std::size_t slot = home(value);
+    while (slots_[slot] != nullptr && !equal_(*slots_[slot], value)) {
+      slot = (slot + 1) & (slots_.size() - 1);
+    }
+    return slot;
+  }
+
+  bool occupied(std::size_t slot) const noexcept { return slots_[slot] != nullptr; }
+
+  void insert(std::size_t slot, const T* element) noexcept
+  {
+    slots_[slot] = element;
+    ++used_;
+  }
+};
+
+/***
+ * ChunkSize is the number of elements each node holds. The default of 1 is
+ * the classic one-element-per-node list; anything larger gives an unrolled
+ * list whose nodes each hold up to ChunkSize consecutive elements, so a scan
+ * follows one pointer per chunk instead of one per element.
+ * UnrolledMiniList<T> (below) picks a chunk that fills about two cache lines.
+ * Links is SinglyLinked or DoublyLinked (see above).
+ * Alloc is any standard allocator for T (std::pmr::polymorphic_allocator
+ * included); nodes are allocated through it rebound to the node type.
+ */
+template <typename T, std::size_t ChunkSize = 1, typename Links = SinglyLinked, typename Alloc = std::allocator<T>>
 class MiniList
 {
+  static_assert(ChunkSize > 0, "MiniList nodes must hold at least one element");
+  static_assert(std::is_same_v<Links, SinglyLinked> || std::is_same_v<Links, DoublyLinked>,
+                "MiniList Links must be SinglyLinked or DoublyLinked");
+
+  constexpr static bool kDoublyLinked = std::is_same_v<Links, DoublyLinked>;
+
 private:
-  template <typename T>
-  struct ListNode
+  struct ListNode : MiniListPriorLink<ListNode, kDoublyLinked>
   {
-    ListNode<T>* next;
-    T data;
+    ListNode* next;
+    std::uint32_t count; // elements in use: data[0] .. data[count - 1]
+    union { T data[ChunkSize]; }; // raw slots; only the first count are constructed
+
+    ListNode() noexcept {}
+    ~ListNode() {}
   };
 
-  constexpr static std::size_t kMaxSize{ 1000 }; // maximum number of list elements
+  using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<ListNode>;
+  using NodeTraits = std::allocator_traits<NodeAlloc>;
 
+public:
+  constexpr static std::size_t kUnbounded{ std::numeric_limits<std::size_t>::max() };
+  constexpr static std::size_t kParallelSortCutoff{ 1 << 16 }; // shorter lists sort serially
+
+private:
   std::size_t length_; // number of active elements
-  ListNode<T>* head_;  // pointer to first node
-  ListNode<T>* tail_;  // pointer to last node
+  ListNode* head_;  // pointer to first node
+  ListNode* tail_;  // pointer to last node
+  NodeAlloc alloc_;
+  std::size_t nodes_;    // nodes currently allocated
+  std::size_t capacity_; // element limit, kUnbounded by default
+
+  ListNode* allocateNode(const char* caller);
+  void freeNode(ListNode* node) noexcept;
+  void freeAllNodes() noexcept;
+  void takeFront(MiniList& source, ListNode*& node, std::uint32_t& index, bool relink);
+  void truncateAfter(ListNode* node, std::size_t index) noexcept;
+  template <typename Fn>
+  static void forEachConcurrently(std::size_t count, Fn fn);
+
+  /* Natural runs for adaptive_sort(): node chains, or spans of a buffer */
+  struct NodeRun
+  {
+    ListNode* head;
+    ListNode* tail;
+    std::size_t length;
+  };
+  struct SpanRun
+  {
+    std::size_t start;
+    std::size_t length;
+  };
+  constexpr static std::size_t kMaxRuns{ 128 }; // run lengths grow like Fibonacci, so this covers any size_t
+  template <typename Run, typename Merge>
+  static void collapseRuns(std::array<Run, kMaxRuns>& runs, std::size_t& count, bool all, Merge merge) noexcept(ChunkSize == 1);
 
 
 public:
   /* Default Constructor */
   MiniList() noexcept;
+  explicit MiniList(const Alloc& alloc) noexcept;
 
   /* Default Destructor */
   ~MiniList();
@@ -46,6 +196,16 @@ public:
   std::size_t size() const noexcept;
   std::size_t max_size() const noexcept;
 
+  /* Bounded use: once size() reaches capacity(), push_back/push_front throw
+   * and try_push_back/try_push_front return false until something is popped.
+   * The limit is copied and swapped along with the elements. */
+  std::size_t capacity() const noexcept;
+  void set_capacity(std::size_t capacity);
+  bool full() const noexcept;
+
+  std::size_t memory_usage() const noexcept; // bytes held by the list and its nodes
+
+  Alloc get_allocator() const noexcept { return Alloc(alloc_); }
 
   /* Swap for copy-and-swap idiom */
   /*
@@ -63,31 +223,72 @@ public:
   */
 
   /* Copy Semantics */
-  MiniList(const MiniList<T>& other) noexcept;
-  MiniList<T>& operator=(MiniList<T> other) noexcept;
+  MiniList(const MiniList& other) noexcept;
+  MiniList& operator=(const MiniList& other); // reuses this list's nodes
 
   /* Move Semantics */
-  MiniList(MiniList<T>&& other) noexcept;
+  MiniList(MiniList&& other) noexcept;
+  MiniList& operator=(MiniList&& other)
+    noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value);
 
   /* Access */
-  T front() const;
-  T back() const;
+  T& front();
+  const T& front() const;
+  T& back();
+  const T& back() const;
 
   /* Modifiers */
-  void push_back(const T& t);
-  void push_front(const T& t);
+  /* emplace_* build the element in its slot in the node; push_* copy or
+   * move the argument in the same way */
+  template <typename... Args>
+  T& emplace_back(Args&&... args);
+  template <typename... Args>
+  T& emplace_front(Args&&... args);
+  void push_back(const T& t) { emplace_back(t); }
+  void push_back(T&& t) { emplace_back(std::move(t)); }
+  void push_front(const T& t) { emplace_front(t); }
+  void push_front(T&& t) { emplace_front(std::move(t)); }
+  bool try_push_back(const T& t);
+  bool try_push_back(T&& t);
+  bool try_push_front(const T& t);
+  bool try_push_front(T&& t);
   void pop_back();
   void pop_front();
-  void swap(MiniList<T>& lhs, MiniList<T>& rhs) noexcept;
+  void swap(MiniList& lhs, MiniList& rhs) noexcept;
   void clear() noexcept;
 
+  /* Replaces the contents with [first, last), assigning over the elements
+   * already in place and only allocating or freeing nodes for the
+   * difference in length */
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last);
+
   /* Operations */
-  void sort() noexcept;
+  void sort() noexcept(ChunkSize == 1); // unrolled lists sort through a scratch buffer
+  void parallel_sort(std::size_t threads = std::thread::hardware_concurrency());
+  void adaptive_sort() noexcept(ChunkSize == 1); // O(n) on input that is already (reverse) sorted
   void unique() noexcept;
-  MiniList<T> merge(const MiniList<T>& lhs, const MiniList<T>& rhs) noexcept;
+  /* Drops every element equal to an earlier one, sorted or not, keeping
+   * first occurrences in order. O(n) expected. */
+  template <typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+  void unique_unsorted(Hash hash = Hash(), KeyEqual equal = KeyEqual());
+  MiniList merge(const MiniList& lhs, const MiniList& rhs) noexcept;
+
+  /* Destructive merge and splice: other is left empty. Nodes are relinked
+   * rather than copied when both lists share an allocator; unrolled lists
+   * (or foreign allocators) move the elements instead, freeing each source
+   * node as soon as it is drained. If a comparison throws, merge leaves
+   * every element in one of the two lists. */
+  void merge(MiniList&& other);
+  void splice(MiniList&& other); // appends all of other in O(1)
+
+  /* k-way merge of sorted lists [first, last) through a min-heap; the
+   * lists are left empty and the result uses the first one's allocator */
+  template <typename ListIt>
+  static MiniList merge_all(ListIt first, ListIt last);
 
   /* Operators */
-  friend std::strong_ordering operator<=>(const MiniList<T>& lhs, const MiniList<T>& rhs) {
+  friend std::strong_ordering operator<=>(const MiniList& lhs, const MiniList& rhs) {
     auto lhsIt = lhs.begin();
     auto rhsIt = rhs.begin();
     while (lhsIt != lhs.end() && rhsIt != rhs.end()) {
@@ -105,27 +306,49 @@ private:
   class Iterator
   {
   private:
-    ListNode<T>* current;
+    ListNode* current;
+    T* position;  // element within current->data, nullptr at end
+    T* chunkEnd;  // one past current's last element
 
   public:
-    Iterator(ListNode<T>* node) noexcept : current(node) {}
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    Iterator() noexcept : current(nullptr), position(nullptr), chunkEnd(nullptr) {}
+    Iterator(ListNode* node) noexcept
+      : current(node),
+        position(node ? node->data : nullptr),
+        chunkEnd(node ? node->data + node->count : nullptr) {}
 
     T& operator*() const noexcept
     {
-      return current->data;
+      return *position;
     }
 
     Iterator& operator++() noexcept
     {
-      current = current->next;
+      if (++position == chunkEnd) {
+        current = current->next;
+        position = current ? current->data : nullptr;
+        chunkEnd = current ? current->data + current->count : nullptr;
+      }
       return *this;
     }
+    Iterator operator++(int) noexcept
+    {
+      Iterator previous = *this;
+      ++*this;
+      return previous;
+    }
     bool operator!=(const Iterator& other) const noexcept
     {
-      return current != other.current;
+      return position != other.position;
     }
     bool operator==(const Iterator& other) const noexcept {
-      return current == other.current;
+      return position == other.position;
     }
   };
 
@@ -134,107 +357,264 @@ public:
   Iterator end() const noexcept { return Iterator(nullptr); }
 };
 
-/* Default Constructor */
+/* Elements per node for an unrolled list: as many as fit in two 64-byte
+ * cache lines alongside the link and count, and at least one. */
 template <typename T>
-MiniList<T>::MiniList() noexcept : length_(0), head_(nullptr), tail_(nullptr) {}
+constexpr std::size_t kUnrolledChunk =
+  sizeof(T) < 128 - 2 * sizeof(void*) ? (128 - 2 * sizeof(void*)) / sizeof(T) : 1;
+
+template <typename T, typename Links = SinglyLinked, typename Alloc = std::allocator<T>>
+using UnrolledMiniList = MiniList<T, kUnrolledChunk<T>, Links, Alloc>;
+
+/* Default Constructor */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+MiniList<T, ChunkSize, Links, Alloc>::MiniList() noexcept
+  : length_(0), head_(nullptr), tail_(nullptr), alloc_(), nodes_(0), capacity_(kUnbounded) {}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+MiniList<T, ChunkSize, Links, Alloc>::MiniList(const Alloc& alloc) noexcept
+  : length_(0), head_(nullptr), tail_(nullptr), alloc_(alloc), nodes_(0), capacity_(kUnbounded) {}
 
 /* Default Destructor */
-template <typename T>
-MiniList<T>::~MiniList()
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+MiniList<T, ChunkSize, Links, Alloc>::~MiniList()
 {
-  ListNode<T>* current = head_;
-  while (current != nullptr)
+  freeAllNodes();
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+typename MiniList<T, ChunkSize, Links, Alloc>::ListNode* MiniList<T, ChunkSize, Links, Alloc>::allocateNode(const char* caller)
+{
+  try
   {
-    ListNode<T>* next = current->next;
-    delete current;
-    current = next;
+    // Element slots are left unconstructed; callers emplace into them
+    ListNode* node = ::new (static_cast<void*>(NodeTraits::allocate(alloc_, 1))) ListNode;
+    ++nodes_;
+    return node;
+  }
+  catch (const std::bad_alloc& e)
+  {
+    /* technically, this string concatenation can fail too... */
+    throw std::runtime_error(std::string(caller) + " could not allocate new node, error: " + std::string(e.what()));
   }
 }
 
-/* Copy Semantics */
-template <typename T>
-MiniList<T>::MiniList(const MiniList<T>& other) noexcept : MiniList()
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::freeNode(ListNode* node) noexcept
 {
-  ListNode<T>* current = other.head_;
-  while (current != nullptr)
+  for (std::uint32_t i = 0; i < node->count; ++i)
   {
-    push_back(current->data);
-    current = current->next;
+    NodeTraits::destroy(alloc_, node->data + i);
   }
+  node->~ListNode();
+  NodeTraits::deallocate(alloc_, node, 1);
+  --nodes_;
 }
 
-template <typename T>
-MiniList<T>& MiniList<T>::operator=(MiniList<T> other) noexcept
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::freeAllNodes() noexcept
 {
-  swap(*this, other);
+  if constexpr (!(MiniListBulkRelease<NodeAlloc>::value && std::is_trivially_destructible_v<T>)) {
+    ListNode* current = head_;
+    while (current != nullptr)
+    {
+      ListNode* next = current->next;
+      freeNode(current);
+      current = next;
+    }
+  }
+  // else nothing to run per node; the arena takes the memory back
+  nodes_ = 0;
+}
+
+/* Copy Semantics */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+MiniList<T, ChunkSize, Links, Alloc>::MiniList(const MiniList& other) noexcept
+  : MiniList(Alloc(NodeTraits::select_on_container_copy_construction(other.alloc_)))
+{
+  capacity_ = other.capacity_;
+  assign(other.begin(), other.end());
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+MiniList<T, ChunkSize, Links, Alloc>& MiniList<T, ChunkSize, Links, Alloc>::operator=(const MiniList& other)
+{
+  if (this == &other)
+  {
+    return *this;
+  }
+
+  if constexpr (NodeTraits::propagate_on_container_copy_assignment::value)
+  {
+    // Nodes from the old allocator cannot be kept once it is replaced
+    if (!(alloc_ == other.alloc_))
+    {
+      clear();
+    }
+    alloc_ = other.alloc_;
+  }
+  capacity_ = other.capacity_;
+  assign(other.begin(), other.end());
   return *this;
 }
 
 /* Move Semantics */
-template <typename T>
-MiniList<T>::MiniList(MiniList<T>&& other) noexcept : MiniList<T>()
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+MiniList<T, ChunkSize, Links, Alloc>::MiniList(MiniList&& other) noexcept : MiniList(Alloc(other.alloc_))
 {
   swap(*this, other);
 }
 
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+MiniList<T, ChunkSize, Links, Alloc>& MiniList<T, ChunkSize, Links, Alloc>::operator=(MiniList&& other)
+  noexcept(NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value)
+{
+  if (this == &other)
+  {
+    return *this;
+  }
+
+  capacity_ = other.capacity_;
+
+  // Nodes may only change hands if this list's allocator can free them
+  if (NodeTraits::propagate_on_container_move_assignment::value || alloc_ == other.alloc_)
+  {
+    clear();
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value)
+    {
+      alloc_ = other.alloc_;
+    }
+    head_ = std::exchange(other.head_, nullptr);
+    tail_ = std::exchange(other.tail_, nullptr);
+    length_ = std::exchange(other.length_, 0);
+    nodes_ = std::exchange(other.nodes_, 0);
+  }
+  else
+  {
+    assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+    other.clear();
+  }
+  return *this;
+}
+
 /* Capacity */
-template <typename T>
-bool MiniList<T>::empty() const noexcept
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+bool MiniList<T, ChunkSize, Links, Alloc>::empty() const noexcept
 {
   return (length_ == 0);
 }
 
-template <typename T>
-std::size_t MiniList<T>::size() const noexcept
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+std::size_t MiniList<T, ChunkSize, Links, Alloc>::size() const noexcept
 {
   return length_;
 }
 
-template <typename T>
-std::size_t MiniList<T>::max_size() const noexcept
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+std::size_t MiniList<T, ChunkSize, Links, Alloc>::max_size() const noexcept
+{
+  std::size_t nodeLimit = NodeTraits::max_size(alloc_);
+  std::size_t allocatorLimit = nodeLimit > kUnbounded / ChunkSize ? kUnbounded : nodeLimit * ChunkSize;
+  return capacity_ < allocatorLimit ? capacity_ : allocatorLimit;
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+std::size_t MiniList<T, ChunkSize, Links, Alloc>::capacity() const noexcept
 {
-  return kMaxSize;
+  return capacity_;
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::set_capacity(std::size_t capacity)
+{
+  if (capacity < length_)
+  {
+    throw std::runtime_error("set_capacity() below the current size");
+  }
+  capacity_ = capacity;
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+bool MiniList<T, ChunkSize, Links, Alloc>::full() const noexcept
+{
+  return (length_ >= capacity_);
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+std::size_t MiniList<T, ChunkSize, Links, Alloc>::memory_usage() const noexcept
+{
+  return sizeof(*this) + nodes_ * sizeof(ListNode);
 }
 
 /* Access */
-template <typename T>
-T MiniList<T>::front() const
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+T& MiniList<T, ChunkSize, Links, Alloc>::front()
 {
   if (empty())
   {
     throw std::runtime_error("front() attempted to access empty list");
   }
-  return head_->data;
+  return head_->data[0];
 }
 
-template <typename T>
-T MiniList<T>::back() const
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+const T& MiniList<T, ChunkSize, Links, Alloc>::front() const
+{
+  return const_cast<MiniList*>(this)->front();
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+T& MiniList<T, ChunkSize, Links, Alloc>::back()
 {
   if (empty())
   {
     throw std::runtime_error("back() attempted to access empty list");
   }
-  return tail_->data;
+  return tail_->data[tail_->count - 1];
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+const T& MiniList<T, ChunkSize, Links, Alloc>::back() const
+{
+  return const_cast<MiniList*>(this)->back();
 }
 
 /* Modifiers */
-template <typename T>
-void MiniList<T>::push_back(const T& t)
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+template <typename... Args>
+T& MiniList<T, ChunkSize, Links, Alloc>::emplace_back(Args&&... args)
 {
-  ListNode<T>* newNode;
+  if (full())
+  {
+    throw std::runtime_error("emplace_back() attempted to exceed capacity");
+  }
+
+  if (!empty() && tail_->count < ChunkSize)
+  {
+    T* slot = tail_->data + tail_->count;
+    NodeTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+    ++tail_->count;
+    ++length_;
+    return *slot;
+  }
 
+  ListNode* newNode = allocateNode("emplace_back()");
+  newNode->count = 0;
   try
   {
-    newNode = new ListNode<T>;
+    NodeTraits::construct(alloc_, newNode->data, std::forward<Args>(args)...);
   }
-  catch (const std::bad_alloc& e)
+  catch (...)
   {
-    /* technically, this string concatenation can fail too... */
-    throw std::runtime_error("insert() could not allocate new node, error: " + std::string(e.what()));
+    freeNode(newNode);
+    throw;
   }
 
   newNode->next = nullptr;
-  newNode->data = t;
+  newNode->count = 1;
+  if constexpr (kDoublyLinked) {
+    newNode->prior = tail_;
+  }
 
   if (empty())
   {
@@ -247,238 +627,1054 @@ void MiniList<T>::push_back(const T& t)
   }
 
   ++length_;
+  return newNode->data[0];
 }
 
-template <typename T>
-void MiniList<T>::push_front(const T& t)
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+template <typename... Args>
+T& MiniList<T, ChunkSize, Links, Alloc>::emplace_front(Args&&... args)
 {
-  ListNode<T>* newNode;
+  if (full())
+  {
+    throw std::runtime_error("emplace_front() attempted to exceed capacity");
+  }
 
+  if constexpr (ChunkSize > 1) {
+    if (!empty() && head_->count < ChunkSize)
+    {
+      // Built before shifting, since args may refer into head_->data
+      T value(std::forward<Args>(args)...);
+      T* first = head_->data;
+      T* last = first + head_->count;
+      NodeTraits::construct(alloc_, last, std::move(last[-1]));
+      std::move_backward(first, last - 1, last);
+      *first = std::move(value);
+      ++head_->count;
+      ++length_;
+      return *first;
+    }
+  }
+
+  ListNode* newNode = allocateNode("emplace_front()");
+  newNode->count = 0;
   try
   {
-    newNode = new ListNode<T>;
+    NodeTraits::construct(alloc_, newNode->data, std::forward<Args>(args)...);
   }
-  catch (const std::bad_alloc& e)
+  catch (...)
   {
-    /* technically, this string concatenation can fail too... */
-    throw std::runtime_error("push_front() could not allocate new node, error: " + std::string(e.what()));
+    freeNode(newNode);
+    throw;
   }
 
-  newNode->data = t;
+  newNode->count = 1;
+  newNode->next = head_;
+  if constexpr (kDoublyLinked) {
+    newNode->prior = nullptr;
+  }
 
   if (empty())
   {
-    newNode->next = nullptr;
-    head_ = tail_ = newNode;
+    tail_ = newNode;
   }
-  else if (size() == 1)
+  else if constexpr (kDoublyLinked)
   {
-    newNode->next = tail_;
-    head_ = newNode;
+    head_->prior = newNode;
   }
-  else
+  head_ = newNode;
+
+  ++length_;
+  return newNode->data[0];
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+bool MiniList<T, ChunkSize, Links, Alloc>::try_push_back(const T& t)
+{
+  if (full())
   {
-    newNode->next = head_;
-    head_ = newNode;
+    return false;
   }
+  push_back(t);
+  return true;
+}
 
-  ++length_;
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+bool MiniList<T, ChunkSize, Links, Alloc>::try_push_back(T&& t)
+{
+  if (full())
+  {
+    return false;
+  }
+  push_back(std::move(t));
+  return true;
 }
 
-template <typename T>
-void MiniList<T>::pop_back()
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+bool MiniList<T, ChunkSize, Links, Alloc>::try_push_front(const T& t)
+{
+  if (full())
+  {
+    return false;
+  }
+  push_front(t);
+  return true;
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+bool MiniList<T, ChunkSize, Links, Alloc>::try_push_front(T&& t)
+{
+  if (full())
+  {
+    return false;
+  }
+  push_front(std::move(t));
+  return true;
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::pop_back()
 {
   if (empty())
   {
     throw std::runtime_error("pop_back attempted to work on empty list");
   }
 
-  if (size() == 1)
+  if (tail_->count > 1)
   {
-    delete head_; // tail_ pointed here too
+    --tail_->count;
+    NodeTraits::destroy(alloc_, tail_->data + tail_->count);
+    --length_;
+  }
+  else if (size() == 1)
+  {
+    freeNode(head_); // tail_ pointed here too
     head_ = tail_ = nullptr;
     length_ = 0;
   }
   else
   {
-    ListNode<T>* newTail = head_;
-    while (newTail->next != tail_)
+    ListNode* newTail;
+    if constexpr (kDoublyLinked)
     {
-      newTail = newTail->next;
+      newTail = tail_->prior;
+    }
+    else
+    {
+      newTail = head_;
+      while (newTail->next != tail_)
+      {
+        newTail = newTail->next;
+      }
     }
-    delete tail_;
+    freeNode(tail_);
     tail_ = newTail;
     tail_->next = nullptr;
     --length_;
   }
 }
 
-template <typename T>
-void MiniList<T>::pop_front()
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::pop_front()
 {
   if (empty())
   {
     throw std::runtime_error("pop_front attempted to work on empty list");
   }
 
-  if (size() == 1)
+  if (head_->count > 1)
+  {
+    std::move(head_->data + 1, head_->data + head_->count, head_->data);
+    --head_->count;
+    NodeTraits::destroy(alloc_, head_->data + head_->count);
+    --length_;
+  }
+  else if (size() == 1)
   {
-    delete head_; // tail_ pointed here too
+    freeNode(head_); // tail_ pointed here too
     head_ = tail_ = nullptr;
     length_ = 0;
   }
   else
   {
-    ListNode<T>* newHead = head_->next;
-    delete head_;
+    ListNode* newHead = head_->next;
+    freeNode(head_);
     head_ = newHead;
+    if constexpr (kDoublyLinked)
+    {
+      head_->prior = nullptr;
+    }
     --length_;
   }
 }
 
-template <typename T>
-void MiniList<T>::swap(MiniList<T>& lhs, MiniList<T>& rhs) noexcept {
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::swap(MiniList& lhs, MiniList& rhs) noexcept {
   using std::swap; // general solution for ensuring correct swap function
 
+  if constexpr (NodeTraits::propagate_on_container_swap::value) {
+    swap(lhs.alloc_, rhs.alloc_);
+  }
   swap(lhs.length_, rhs.length_);
   swap(lhs.head_, rhs.head_);
   swap(lhs.tail_, rhs.tail_);
+  swap(lhs.nodes_, rhs.nodes_);
+  swap(lhs.capacity_, rhs.capacity_);
 }
 
-template <typename T>
-void MiniList<T>::clear() noexcept {
-  if (empty()) {
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::clear() noexcept {
+  freeAllNodes();
+  head_ = tail_ = nullptr;
+  length_ = 0;
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+template <typename InputIt>
+void MiniList<T, ChunkSize, Links, Alloc>::assign(InputIt first, InputIt last) {
+  ListNode* prior = nullptr;
+  ListNode* node = head_;
+  std::uint32_t i = 0;
+
+  // Overwrite the elements already in place
+  while (node != nullptr && first != last) {
+    for (i = 0; i < node->count && first != last; ++i, ++first) {
+      node->data[i] = *first;
+    }
+    if (i < node->count) {
+      break;
+    }
+    prior = node;
+    node = node->next;
+    i = 0;
+  }
+
+  // More input than elements: the rest goes on the end
+  for (; first != last; ++first) {
+    emplace_back(*first);
+  }
+
+  if (node == nullptr) {
     return;
   }
-  do {
-    pop_front();
-  } while (!empty());
+
+  // Less input than elements: drop the ones not overwritten
+  if (i > 0) {
+    for (std::uint32_t j = i; j < node->count; ++j) {
+      NodeTraits::destroy(alloc_, node->data + j);
+    }
+    length_ -= node->count - i;
+    node->count = i;
+    prior = node;
+    node = node->next;
+  }
+
+  tail_ = prior;
+  if (prior != nullptr) {
+    prior->next = nullptr;
+  }
+  else {
+    head_ = nullptr;
+  }
+
+  while (node != nullptr) {
+    ListNode* next = node->next;
+    length_ -= node->count;
+    freeNode(node);
+    node = next;
+  }
 }
 
 /***
  * MergeSort for LinkedList
  * Inspired by: Simon Tatham | https://www.chiark.greenend.org.uk/~sgtatham/algorithms/listsort.html
+ *
+ * Unrolled lists instead move their elements into a contiguous buffer,
+ * stable_sort it and move them back, keeping the nodes where they are.
  */
-template <typename T>
-void MiniList<T>::sort() noexcept {
-  if (empty() || head_ == tail_) {
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::sort() noexcept(ChunkSize == 1) {
+  if (length_ < 2) {
     return; // List is empty or has only one element, no need to sort
   }
 
-  ListNode<T>* mergeStart{};
-  ListNode<T>* nextSublistStart{};
-  ListNode<T>* selectedNode{};
-  std::size_t currentSublistSize{};
-  std::size_t nextSublistSize{};
-  std::size_t mergeSize = 1;
-  bool done{};
+  if constexpr (ChunkSize > 1) {
+    std::vector<T> buffer;
+    buffer.reserve(length_);
+    for (ListNode* node = head_; node != nullptr; node = node->next) {
+      for (std::size_t i = 0; i < node->count; ++i) {
+        buffer.push_back(std::move(node->data[i]));
+      }
+    }
 
-  do {
-    mergeStart = head_;
-    head_ = nullptr;
-    tail_ = nullptr;
-    done = true;
+    std::stable_sort(buffer.begin(), buffer.end());
 
-    while (mergeStart) {
-      nextSublistStart = mergeStart;
-      currentSublistSize = 0;
-      for (std::size_t i = 0; i < mergeSize && nextSublistStart; ++i) {
-        ++currentSublistSize;
-        nextSublistStart = nextSublistStart->next;
+    auto source = buffer.begin();
+    for (ListNode* node = head_; node != nullptr; node = node->next) {
+      for (std::size_t i = 0; i < node->count; ++i) {
+        node->data[i] = std::move(*source++);
       }
+    }
+  }
+  else {
+    ListNode* mergeStart{};
+    ListNode* nextSublistStart{};
+    ListNode* selectedNode{};
+    std::size_t currentSublistSize{};
+    std::size_t nextSublistSize{};
+    std::size_t mergeSize = 1;
+    bool done{};
+
+    do {
+      mergeStart = head_;
+      head_ = nullptr;
+      tail_ = nullptr;
+      done = true;
+
+      while (mergeStart) {
+        nextSublistStart = mergeStart;
+        currentSublistSize = 0;
+        for (std::size_t i = 0; i < mergeSize && nextSublistStart; ++i) {
+          ++currentSublistSize;
+          nextSublistStart = nextSublistStart->next;
+        }
 
-      nextSublistSize = mergeSize;
-      while (currentSublistSize > 0 || (nextSublistSize > 0 && nextSublistStart)) {
-        if (currentSublistSize == 0) {
-          selectedNode = nextSublistStart; nextSublistStart = nextSublistStart->next; --nextSublistSize;
+        nextSublistSize = mergeSize;
+        while (currentSublistSize > 0 || (nextSublistSize > 0 && nextSublistStart)) {
+          if (currentSublistSize == 0) {
+            selectedNode = nextSublistStart; nextSublistStart = nextSublistStart->next; --nextSublistSize;
+          }
+          else if (nextSublistSize == 0 || !nextSublistStart) {
+            selectedNode = mergeStart; mergeStart = mergeStart->next; --currentSublistSize;
+          }
+          else if (mergeStart->data[0] <= nextSublistStart->data[0]) {
+            selectedNode = mergeStart; mergeStart = mergeStart->next; --currentSublistSize;
+          }
+          else {
+            selectedNode = nextSublistStart; nextSublistStart = nextSublistStart->next; --nextSublistSize;
+          }
+
+          if (tail_) {
+            tail_->next = selectedNode;
+          }
+          else {
+            head_ = selectedNode;
+          }
+          if constexpr (kDoublyLinked) {
+            selectedNode->prior = tail_;
+          }
+          tail_ = selectedNode;
+          tail_->next = nullptr;
         }
-        else if (nextSublistSize == 0 || !nextSublistStart) {
-          selectedNode = mergeStart; mergeStart = mergeStart->next; --currentSublistSize;
+
+        mergeStart = nextSublistStart;
+        done = done && nextSublistStart == nullptr;
+      }
+      mergeSize *= 2;
+    } while (!done);
+  }
+}
+
+/***
+ * Runs fn(0) .. fn(count - 1) at once, fn(0) on the calling thread and the
+ * rest on threads of their own, and waits for all of them. If a thread
+ * cannot be started its share runs here instead. An exception from any
+ * fn(i) is kept until every thread has been joined, then the one from the
+ * lowest i is rethrown.
+ */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+template <typename Fn>
+void MiniList<T, ChunkSize, Links, Alloc>::forEachConcurrently(std::size_t count, Fn fn) {
+  std::vector<std::exception_ptr> errors(count);
+  auto run = [&fn, &errors](std::size_t i) noexcept {
+    try {
+      fn(i);
+    }
+    catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(count);
+  for (std::size_t i = 1; i < count; ++i) {
+    try {
+      workers.emplace_back(run, i);
+    }
+    catch (const std::system_error&) {
+      run(i);
+    }
+  }
+
+  run(0);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+/***
+ * Parallel merge sort: the list is cut into one run per thread, the runs
+ * are sorted concurrently with sort(), then merged pairwise, each round of
+ * merges again running concurrently. Merging relinks nodes, so nothing is
+ * allocated. Unrolled lists do the same over a contiguous scratch buffer
+ * (stable_sort, then inplace_merge) so no thread allocates nodes.
+ * Stable like sort(). Lists under kParallelSortCutoff just call sort().
+ */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::parallel_sort(std::size_t threads) {
+  threads = std::min(threads, length_ / (kParallelSortCutoff / 2));
+  if (length_ < kParallelSortCutoff || threads < 2) {
+    sort();
+    return;
+  }
+
+  if constexpr (ChunkSize > 1) {
+    std::vector<T> buffer;
+    buffer.reserve(length_);
+    for (ListNode* node = head_; node != nullptr; node = node->next) {
+      for (std::size_t i = 0; i < node->count; ++i) {
+        buffer.push_back(std::move(node->data[i]));
+      }
+    }
+
+    std::vector<typename std::vector<T>::iterator> bounds;
+    for (std::size_t i = 0; i <= threads; ++i) {
+      bounds.push_back(buffer.begin() + buffer.size() * i / threads);
+    }
+    auto moveBack = [&]() {
+      auto source = buffer.begin();
+      for (ListNode* node = head_; node != nullptr; node = node->next) {
+        for (std::size_t i = 0; i < node->count; ++i) {
+          node->data[i] = std::move(*source++);
         }
-        else if (mergeStart->data <= nextSublistStart->data) {
-          selectedNode = mergeStart; mergeStart = mergeStart->next; --currentSublistSize;
+      }
+    };
+
+    try {
+      forEachConcurrently(threads, [&](std::size_t i) {
+        std::stable_sort(bounds[i], bounds[i + 1]);
+      });
+      for (std::size_t width = 1; width < threads; width *= 2) {
+        forEachConcurrently((threads + 2 * width - 1) / (2 * width), [&](std::size_t pair) {
+          std::size_t lo = pair * 2 * width;
+          std::size_t mid = std::min(lo + width, threads);
+          std::size_t hi = std::min(lo + 2 * width, threads);
+          std::inplace_merge(bounds[lo], bounds[mid], bounds[hi]);
+        });
+      }
+    }
+    catch (...) {
+      moveBack(); // partly sorted, but every element is back in the list
+      throw;
+    }
+    moveBack();
+  }
+  else {
+    std::vector<MiniList> runs;
+    runs.reserve(threads);
+
+    ListNode* node = head_;
+    for (std::size_t i = 0; i < threads; ++i) {
+      std::size_t count = length_ * (i + 1) / threads - length_ * i / threads;
+      MiniList& run = runs.emplace_back(get_allocator());
+      run.head_ = node;
+      for (std::size_t k = 1; k < count; ++k) {
+        node = node->next;
+      }
+      run.tail_ = node;
+      node = node->next;
+      run.tail_->next = nullptr;
+      if constexpr (kDoublyLinked) {
+        run.head_->prior = nullptr;
+      }
+      run.length_ = run.nodes_ = count;
+    }
+    head_ = tail_ = nullptr;
+    length_ = nodes_ = 0;
+
+    try {
+      forEachConcurrently(threads, [&](std::size_t i) {
+        runs[i].sort();
+      });
+      for (std::size_t width = 1; width < threads; width *= 2) {
+        forEachConcurrently((threads + 2 * width - 1) / (2 * width), [&](std::size_t pair) {
+          std::size_t lo = pair * 2 * width;
+          if (lo + width < threads) {
+            runs[lo].merge(std::move(runs[lo + width]));
+          }
+        });
+      }
+    }
+    catch (...) {
+      for (MiniList& run : runs) {
+        splice(std::move(run)); // partly sorted, but every element is back in the list
+      }
+      throw;
+    }
+    splice(std::move(runs[0]));
+  }
+}
+
+/***
+ * Keeps the run stack balanced the way TimSort does (with the corrected
+ * invariant of de Gouw et al.): merges the top runs until each run is longer
+ * than the two above it combined, or, with all, until one run is left.
+ * Only neighbouring runs are merged, which keeps the sort stable.
+ */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+template <typename Run, typename Merge>
+void MiniList<T, ChunkSize, Links, Alloc>::collapseRuns(std::array<Run, kMaxRuns>& runs, std::size_t& count, bool all, Merge merge) noexcept(ChunkSize == 1) {
+  while (count > 1) {
+    std::size_t n = count - 2;
+    if (all) {
+      if (n > 0 && runs[n - 1].length < runs[n + 1].length) {
+        --n;
+      }
+    }
+    else if ((n > 0 && runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+             (n > 1 && runs[n - 2].length <= runs[n - 1].length + runs[n].length)) {
+      if (runs[n - 1].length < runs[n + 1].length) {
+        --n;
+      }
+    }
+    else if (runs[n].length > runs[n + 1].length) {
+      break;
+    }
+
+    runs[n] = merge(runs[n], runs[n + 1]);
+    for (std::size_t i = n + 1; i + 1 < count; ++i) {
+      runs[i] = runs[i + 1];
+    }
+    --count;
+  }
+}
+
+/***
+ * Natural merge sort: the list is read as a sequence of runs that are
+ * already in order, non-descending or strictly descending (reversed on the
+ * spot, which keeps equal elements in order), and neighbouring runs are
+ * merged as they stack up. Sorted or reverse-sorted input is one run and
+ * costs a single pass; a merge whose runs are already in order just links
+ * them. Unrolled lists find the runs in a scratch buffer and merge with
+ * inplace_merge, skipping the buffer entirely when the list is sorted.
+ */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::adaptive_sort() noexcept(ChunkSize == 1) {
+  if (length_ < 2) {
+    return;
+  }
+
+  if constexpr (ChunkSize > 1) {
+    if (std::is_sorted(begin(), end())) {
+      return;
+    }
+
+    std::vector<T> buffer;
+    buffer.reserve(length_);
+    for (ListNode* node = head_; node != nullptr; node = node->next) {
+      for (std::size_t i = 0; i < node->count; ++i) {
+        buffer.push_back(std::move(node->data[i]));
+      }
+    }
+
+    auto mergeSpans = [&buffer](const SpanRun& lower, const SpanRun& upper) {
+      auto middle = buffer.begin() + upper.start;
+      if (*middle < *(middle - 1)) {
+        std::inplace_merge(buffer.begin() + lower.start, middle, middle + upper.length);
+      }
+      return SpanRun{ lower.start, lower.length + upper.length };
+    };
+
+    std::array<SpanRun, kMaxRuns> runs;
+    std::size_t count = 0;
+    std::size_t start = 0;
+    while (start < buffer.size()) {
+      std::size_t end = start + 1;
+      if (end < buffer.size() && buffer[end] < buffer[start]) {
+        while (end < buffer.size() && buffer[end] < buffer[end - 1]) {
+          ++end;
         }
-        else {
-          selectedNode = nextSublistStart; nextSublistStart = nextSublistStart->next; --nextSublistSize;
+        std::reverse(buffer.begin() + start, buffer.begin() + end);
+      }
+      else {
+        while (end < buffer.size() && !(buffer[end] < buffer[end - 1])) {
+          ++end;
         }
+      }
+      runs[count++] = SpanRun{ start, end - start };
+      collapseRuns(runs, count, false, mergeSpans);
+      start = end;
+    }
+    collapseRuns(runs, count, true, mergeSpans);
 
-        if (tail_) {
-          tail_->next = selectedNode;
+    auto source = buffer.begin();
+    for (ListNode* node = head_; node != nullptr; node = node->next) {
+      for (std::size_t i = 0; i < node->count; ++i) {
+        node->data[i] = std::move(*source++);
+      }
+    }
+  }
+  else {
+    auto mergeNodes = [](const NodeRun& lower, const NodeRun& upper) noexcept {
+      NodeRun merged{ nullptr, nullptr, lower.length + upper.length };
+      if (!(upper.head->data[0] < lower.tail->data[0])) {
+        lower.tail->next = upper.head; // already in order
+        merged.head = lower.head;
+        merged.tail = upper.tail;
+        return merged;
+      }
+
+      ListNode* a = lower.head;
+      ListNode* b = upper.head;
+      ListNode* tail;
+      if (b->data[0] < a->data[0]) {
+        merged.head = tail = b;
+        b = b->next;
+      }
+      else {
+        merged.head = tail = a;
+        a = a->next;
+      }
+      while (a != nullptr && b != nullptr) {
+        if (b->data[0] < a->data[0]) {
+          tail = tail->next = b;
+          b = b->next;
         }
         else {
-          head_ = selectedNode;
+          tail = tail->next = a;
+          a = a->next;
         }
-        tail_ = selectedNode;
-        tail_->next = nullptr;
       }
-
-      mergeStart = nextSublistStart;
-      done = done && nextSublistStart == nullptr;
+      if (a != nullptr) {
+        tail->next = a;
+        merged.tail = lower.tail;
+      }
+      else {
+        tail->next = b;
+        merged.tail = upper.tail;
+      }
+      return merged;
+    };
+
+    std::array<NodeRun, kMaxRuns> runs;
+    std::size_t count = 0;
+    ListNode* node = head_;
+    while (node != nullptr) {
+      NodeRun run{ node, node, 1 };
+      ListNode* next = node->next;
+      if (next != nullptr && next->data[0] < node->data[0]) {
+        // Strictly descending: reverse the links while walking it
+        node->next = nullptr;
+        while (next != nullptr && next->data[0] < run.head->data[0]) {
+          ListNode* after = next->next;
+          next->next = run.head;
+          run.head = next;
+          next = after;
+          ++run.length;
+        }
+      }
+      else {
+        while (next != nullptr && !(next->data[0] < run.tail->data[0])) {
+          run.tail = next;
+          next = next->next;
+          ++run.length;
+        }
+        run.tail->next = nullptr;
+      }
+      runs[count++] = run;
+      collapseRuns(runs, count, false, mergeNodes);
+      node = next;
+    }
+    collapseRuns(runs, count, true, mergeNodes);
+
+    head_ = runs[0].head;
+    tail_ = runs[0].tail;
+    if constexpr (kDoublyLinked) {
+      ListNode* prior = nullptr;
+      for (ListNode* current = head_; current != nullptr; current = current->next) {
+        current->prior = prior;
+        prior = current;
+      }
     }
-    mergeSize *= 2;
-  } while (!done);
+  }
 }
 
 /***
  * unique() finds adjacent duplicate `data` values from `ListNode`.
  * List must be sorted for unique() to work correctly.
- * TODO: Random access unique() function for unsorted lists.
+ * Unrolled lists compact the survivors towards the front and free the
+ * nodes left empty at the end.
+ * Lists that are not sorted can use unique_unsorted().
  */
-template <typename T>
-void MiniList<T>::unique() noexcept {
-  if (empty() || head_ == tail_) {
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::unique() noexcept {
+  if (length_ < 2) {
     return;
   }
 
-  ListNode<T>* current = head_;
-  while (current->next != nullptr) {
-    if (current->data == current->next->data) {
-      ListNode<T>* toDelete = current->next;
-      current->next = current->next->next;
-      delete toDelete;
-      if (current->next == nullptr) {
-        tail_ = current;
+  if constexpr (ChunkSize > 1) {
+    ListNode* kept = head_;   // node holding the last element kept
+    std::size_t keptIndex = 0;
+
+    for (auto it = ++begin(); it != end(); ++it) {
+      if (*it == kept->data[keptIndex]) {
+        --length_;
+        continue;
+      }
+      if (++keptIndex == kept->count) {
+        kept = kept->next;
+        keptIndex = 0;
+      }
+      if (&kept->data[keptIndex] != &*it) {
+        kept->data[keptIndex] = std::move(*it);
       }
     }
-    else {
-      current = current->next;
+
+    truncateAfter(kept, keptIndex);
+  }
+  else {
+    ListNode* current = head_;
+    while (current->next != nullptr) {
+      if (current->data[0] == current->next->data[0]) {
+        ListNode* toDelete = current->next;
+        current->next = current->next->next;
+        freeNode(toDelete);
+        --length_;
+        if (current->next == nullptr) {
+          tail_ = current;
+        }
+        else if constexpr (kDoublyLinked) {
+          current->next->prior = current;
+        }
+      }
+      else {
+        current = current->next;
+      }
     }
   }
 }
 
 /***
  * Merge Sorted Lists
- * 
+ *
  * Lists must be sorted prior to merging. It is not necessary to have unique values.
  * TODO: Verify sorted lists before merge.
  * TODO: Merge unsorted lists.
  */
-template <typename T>
-MiniList<T> MiniList<T>::merge(const MiniList<T>& lhs, const MiniList<T>& rhs) noexcept {
-  MiniList<T> mergedList{};
-  ListNode<T>* lhs_node = lhs.head_;
-  ListNode<T>* rhs_node = rhs.head_;
-
-  while (lhs_node != nullptr && rhs_node != nullptr) {
-    if (lhs_node->data < rhs_node->data) {
-      mergedList.push_back(lhs_node->data);
-      lhs_node = lhs_node->next;
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+MiniList<T, ChunkSize, Links, Alloc> MiniList<T, ChunkSize, Links, Alloc>::merge(const MiniList& lhs, const MiniList& rhs) noexcept {
+  MiniList mergedList(lhs.get_allocator());
+  auto lhsIt = lhs.begin();
+  auto rhsIt = rhs.begin();
+
+  while (lhsIt != lhs.end() && rhsIt != rhs.end()) {
+    if (*lhsIt < *rhsIt) {
+      mergedList.push_back(*lhsIt);
+      ++lhsIt;
     }
     else {
-      mergedList.push_back(rhs_node->data);
-      rhs_node = rhs_node->next;
+      mergedList.push_back(*rhsIt);
+      ++rhsIt;
     }
   }
-  while (lhs_node != nullptr) {
-    mergedList.push_back(lhs_node->data);
-    lhs_node = lhs_node->next;
+  while (lhsIt != lhs.end()) {
+    mergedList.push_back(*lhsIt);
+    ++lhsIt;
   }
-  while (rhs_node != nullptr) {
-    mergedList.push_back(rhs_node->data);
-    rhs_node = rhs_node->next;
+  while (rhsIt != rhs.end()) {
+    mergedList.push_back(*rhsIt);
+    ++rhsIt;
   }
 
   return mergedList;
 }
 
+/***
+ * Moves the front element of a merge source, at node->data[index], onto the
+ * back of this list and advances node/index. With relink (single-element
+ * nodes, equal allocators) the node itself changes lists; otherwise the
+ * element is moved and the node freed once it is used up. The source's
+ * head_ follows along so it stays a valid list if an exception escapes.
+ */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::takeFront(MiniList& source, ListNode*& node, std::uint32_t& index, bool relink) {
+  if (relink) {
+    ListNode* taken = node;
+    node = node->next;
+    --source.nodes_;
+    --source.length_;
+
+    taken->next = nullptr;
+    if constexpr (kDoublyLinked) {
+      taken->prior = tail_;
+    }
+    if (tail_ != nullptr) {
+      tail_->next = taken;
+    }
+    else {
+      head_ = taken;
+    }
+    tail_ = taken;
+    ++nodes_;
+    ++length_;
+  }
+  else {
+    emplace_back(std::move(node->data[index]));
+    if (++index == node->count) {
+      ListNode* next = node->next;
+      source.length_ -= node->count;
+      source.freeNode(node);
+      node = next;
+      index = 0;
+    }
+  }
+
+  source.head_ = node;
+  if (node == nullptr) {
+    source.tail_ = nullptr;
+  }
+  else if constexpr (kDoublyLinked) {
+    node->prior = nullptr;
+  }
+}
+
+/***
+ * Merge other, sorted, into this sorted list. Stable: of equal elements,
+ * those already in this list come first.
+ */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::merge(MiniList&& other) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  if (other.length_ > capacity_ - length_) {
+    throw std::runtime_error("merge() attempted to exceed capacity");
+  }
+
+  MiniList mine(std::move(*this));
+  capacity_ = mine.capacity_;
+
+  const bool relinkMine = (ChunkSize == 1);
+  const bool relinkOther = (ChunkSize == 1 && alloc_ == other.alloc_);
+  ListNode* lhs = mine.head_;
+  ListNode* rhs = other.head_;
+  std::uint32_t lhsIndex = 0;
+  std::uint32_t rhsIndex = 0;
+
+  // A source node partly moved from (unrolled lists) still counts the
+  // moved-from elements; drop them so the source holds only its rest
+  auto dropTaken = [](MiniList& source, ListNode* node, std::uint32_t index) {
+    if (index == 0) {
+      return;
+    }
+    std::move(node->data + index, node->data + node->count, node->data);
+    for (std::uint32_t i = node->count - index; i < node->count; ++i) {
+      NodeTraits::destroy(source.alloc_, node->data + i);
+    }
+    node->count -= index;
+    source.length_ -= index;
+  };
+
+  try {
+    while (lhs != nullptr && rhs != nullptr) {
+      if (rhs->data[rhsIndex] < lhs->data[lhsIndex]) {
+        takeFront(other, rhs, rhsIndex, relinkOther);
+      }
+      else {
+        takeFront(mine, lhs, lhsIndex, relinkMine);
+      }
+    }
+  }
+  catch (...) {
+    // A comparison threw: this list keeps what was merged so far plus the
+    // rest of its own elements, other keeps the rest of its own
+    dropTaken(mine, lhs, lhsIndex);
+    dropTaken(other, rhs, rhsIndex);
+    splice(std::move(mine));
+    throw;
+  }
+  while (lhs != nullptr) {
+    takeFront(mine, lhs, lhsIndex, relinkMine);
+  }
+  while (rhs != nullptr) {
+    takeFront(other, rhs, rhsIndex, relinkOther);
+  }
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::splice(MiniList&& other) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  if (other.length_ > capacity_ - length_) {
+    throw std::runtime_error("splice() attempted to exceed capacity");
+  }
+
+  if (!(alloc_ == other.alloc_)) {
+    for (auto it = other.begin(); it != other.end(); ++it) {
+      emplace_back(std::move(*it));
+    }
+    other.clear();
+    return;
+  }
+
+  if (empty()) {
+    head_ = other.head_;
+  }
+  else {
+    tail_->next = other.head_;
+    if constexpr (kDoublyLinked) {
+      other.head_->prior = tail_;
+    }
+  }
+  tail_ = other.tail_;
+  length_ += std::exchange(other.length_, 0);
+  nodes_ += std::exchange(other.nodes_, 0);
+  other.head_ = other.tail_ = nullptr;
+}
+
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+template <typename ListIt>
+MiniList<T, ChunkSize, Links, Alloc> MiniList<T, ChunkSize, Links, Alloc>::merge_all(ListIt first, ListIt last) {
+  struct Source
+  {
+    MiniList* list;
+    ListNode* node;
+    std::uint32_t index;
+    std::size_t order;  // position in [first, last), breaks ties stably
+    bool relink;
+  };
+
+  /* the result takes the first list's allocator, and an empty range has
+     none to take, which only a default-constructible allocator can cover */
+  if (first == last) {
+    if constexpr (std::is_default_constructible_v<Alloc>) {
+      return MiniList();
+    }
+    else {
+      throw std::runtime_error("No lists to take an allocator from in `merge_all`");
+    }
+  }
+
+  MiniList merged(first->get_allocator());
+  std::vector<Source> heap;
+  std::size_t order = 0;
+  for (ListIt it = first; it != last; ++it, ++order) {
+    MiniList& list = *it;
+    if (!list.empty()) {
+      heap.push_back({ &list, list.head_, 0, order, ChunkSize == 1 && merged.alloc_ == list.alloc_ });
+    }
+  }
+
+  // std heaps keep the largest on top, so "less" here means "comes later"
+  auto later = [](const Source& lhs, const Source& rhs) {
+    const T& a = lhs.node->data[lhs.index];
+    const T& b = rhs.node->data[rhs.index];
+    return b < a || (!(a < b) && lhs.order > rhs.order);
+  };
+  std::make_heap(heap.begin(), heap.end(), later);
+
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    Source& source = heap.back();
+    merged.takeFront(*source.list, source.node, source.index, source.relink);
+    if (source.node != nullptr) {
+      std::push_heap(heap.begin(), heap.end(), later);
+    }
+    else {
+      heap.pop_back();
+    }
+  }
+
+  return merged;
+}
+
+/* Unrolled compaction: drops everything after node->data[index] */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+void MiniList<T, ChunkSize, Links, Alloc>::truncateAfter(ListNode* node, std::size_t index) noexcept {
+  for (std::size_t i = index + 1; i < node->count; ++i) {
+    NodeTraits::destroy(alloc_, node->data + i);
+  }
+  node->count = static_cast<std::uint32_t>(index + 1);
+
+  ListNode* current = node->next;
+  while (current != nullptr) {
+    ListNode* next = current->next;
+    freeNode(current);
+    current = next;
+  }
+  node->next = nullptr;
+  tail_ = node;
+}
+
+/***
+ * unique_unsorted() remembers each element kept in a MiniListSeenSet and
+ * drops any later element already in it. Kept elements never move once
+ * placed (unrolled lists only compact forwards), so the set can point at
+ * them instead of copying them.
+ */
+template <typename T, std::size_t ChunkSize, typename Links, typename Alloc>
+template <typename Hash, typename KeyEqual>
+void MiniList<T, ChunkSize, Links, Alloc>::unique_unsorted(Hash hash, KeyEqual equal) {
+  if (length_ < 2) {
+    return;
+  }
+
+  MiniListSeenSet<T, Hash, KeyEqual> seen(hash, equal);
+
+  if constexpr (ChunkSize > 1) {
+    ListNode* kept = head_;   // node holding the last element kept
+    std::size_t keptIndex = 0;
+    std::size_t dropped = 0;  // applied at the end, so a throwing find() leaves sizes intact
+    seen.insert(seen.find(head_->data[0]), head_->data);
+
+    for (auto it = ++begin(); it != end(); ++it) {
+      std::size_t slot = seen.find(*it);
+      if (seen.occupied(slot)) {
+        ++dropped;
+        continue;
+      }
+      if (++keptIndex == kept->count) {
+        kept = kept->next;
+        keptIndex = 0;
+      }
+      if (&kept->data[keptIndex] != &*it) {
+        kept->data[keptIndex] = std::move(*it);
+      }
+      seen.insert(slot, &kept->data[keptIndex]);
+    }
+
+    length_ -= dropped;
+    truncateAfter(kept, keptIndex);
+  }
+  else {
+    ListNode* current = head_;
+    seen.insert(seen.find(current->data[0]), current->data);
+    while (current->next != nullptr) {
+      ListNode* candidate = current->next;
+      std::size_t slot = seen.find(candidate->data[0]);
+      if (seen.occupied(slot)) {
+        current->next = candidate->next;
+        freeNode(candidate);
+        --length_;
+        if (current->next == nullptr) {
+          tail_ = current;
+        }
+        else if constexpr (kDoublyLinked) {
+          current->next->prior = current;
+        }
+      }
+      else {
+        seen.insert(slot, candidate->data);
+        current = candidate;
+      }
+    }
+  }
+}
+
 #endif // MINILIST_HPP_
\ No newline at end of file
@@ -0,0 +1,96 @@
+/****
+ *
+ * allocbench.cpp
+ *
+ * Time to fill a MiniList<int> with push_back and then clear() it, for each
+ * node allocator: plain new/delete (std::allocator), the MiniPool free list,
+ * the MiniArena bump allocator, and the two std::pmr resources that match
+ * them. Stand-alone driver, e.g.:
+ *
+ *   g++ -O2 -std=c++20 allocbench.cpp -o allocbench
+ *   allocbench                      (10^6, 10^7 and 10^8 nodes)
+ *   allocbench 1000000 5000000      (just these sizes)
+ *
+ * 10^8 single-int nodes take about 1.6 GB per list.
+ */
+
+#include "MiniList.hpp"
+#include "MiniAllocators.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+struct Timing
+{
+  double fillMs;
+  double clearMs;
+};
+
+template <typename List>
+Timing run(List& list, std::size_t nodes)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < nodes; ++i) {
+    list.push_back(static_cast<int>(i));
+  }
+  const auto filled = std::chrono::steady_clock::now();
+  list.clear();
+  const auto cleared = std::chrono::steady_clock::now();
+
+  return { std::chrono::duration<double, std::milli>(filled - start).count(),
+           std::chrono::duration<double, std::milli>(cleared - filled).count() };
+}
+
+void report(const char* name, const Timing& timing)
+{
+  std::cout << "  " << std::left << std::setw(28) << name << std::right
+            << std::setw(12) << timing.fillMs << std::setw(12) << timing.clearMs << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::size_t> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.push_back(static_cast<std::size_t>(std::strtoull(argv[i], nullptr, 10)));
+  }
+  if (sizes.empty()) {
+    sizes = { 1000000, 10000000, 100000000 };
+  }
+
+  std::cout << std::fixed << std::setprecision(1);
+  for (std::size_t nodes : sizes) {
+    std::cout << std::left << std::setw(30) << (std::to_string(nodes) + " nodes") << std::right
+              << std::setw(12) << "fill ms" << std::setw(12) << "clear ms" << '\n';
+
+    {
+      MiniList<int> list;
+      report("new/delete", run(list, nodes));
+    }
+    {
+      MiniPool pool;
+      MiniList<int, 1, SinglyLinked, PoolAllocator<int>> list{ PoolAllocator<int>(pool) };
+      report("MiniPool", run(list, nodes));
+    }
+    {
+      MiniArena arena;
+      MiniList<int, 1, SinglyLinked, ArenaAllocator<int>> list{ ArenaAllocator<int>(arena) };
+      report("MiniArena", run(list, nodes));
+    }
+    {
+      std::pmr::unsynchronized_pool_resource resource;
+      MiniList<int, 1, SinglyLinked, std::pmr::polymorphic_allocator<int>> list{ &resource };
+      report("pmr unsynchronized_pool", run(list, nodes));
+    }
+    {
+      std::pmr::monotonic_buffer_resource resource;
+      MiniList<int, 1, SinglyLinked, std::pmr::polymorphic_allocator<int>> list{ &resource };
+      report("pmr monotonic_buffer", run(list, nodes));
+    }
+    std::cout << '\n';
+  }
+}
\ No newline at end of file